@@ -1,6 +1,11 @@
 #ifndef ALGOBASE_HPP
 #define ALGOBASE_HPP
 
+#if __cplusplus >= 201103L
+# include <type_traits>
+# include <utility>
+#endif
+
 namespace ft
 {
 	template <class InputIterator1, class InputIterator2>
@@ -51,6 +56,24 @@ namespace ft
 			second = pr.second;
 			return *this;
 		}
+
+#if __cplusplus >= 201103L
+		pair(const pair&) = default;
+		pair(pair&&) = default;
+
+		template<class U, class V, class = typename std::enable_if<
+			std::is_constructible<T1, U&&>::value && std::is_constructible<T2, V&&>::value>::type>
+		pair (U&& x, V&& y) : first(std::forward<U>(x)), second(std::forward<V>(y)) {}
+
+		template<class U, class V>
+		pair (pair<U,V>&& pr) : first(std::forward<U>(pr.first)), second(std::forward<V>(pr.second)) {}
+
+		pair& operator= (pair&& pr) {
+			first = std::forward<T1>(pr.first);
+			second = std::forward<T2>(pr.second);
+			return *this;
+		}
+#endif
 	};
 
 	template <class T1, class T2>
@@ -83,10 +106,26 @@ namespace ft
 		return !(lhs < rhs);
 	}
 
+	// operator< on whatever it is handed, for heterogeneous lookup in
+	// map and set (std::less<void> is C++14);
+	struct transparent_less
+	{
+		typedef void	is_transparent;
+
+		template <class T, class U>
+		bool	operator()(const T& x, const U& y) const {
+			return x < y;
+		}
+	};
+
 	template <class T1,class T2>
 	pair<T1,T2> make_pair (T1 x, T2 y)
 	{
+#if __cplusplus >= 201103L
+	return ( pair<T1,T2>(std::move(x), std::move(y)) );
+#else
 	return ( pair<T1,T2>(x,y) );
+#endif
 	}
 
 }
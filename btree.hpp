@@ -0,0 +1,833 @@
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include <memory>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include "algobase.hpp"
+#include "iterator.hpp"
+
+namespace ft
+{
+	// slots per node so that a node stays near TargetNodeSize bytes;
+	template <class Val, std::size_t TargetNodeSize>
+	struct btree_slots
+	{
+		static const std::size_t	fit = (TargetNodeSize > 16 ? TargetNodeSize - 16 : 0) / sizeof(Val);
+		static const std::size_t	value = fit < 3 ? 3 : fit;
+	};
+
+	template <class Val, std::size_t N>
+	struct btree_internal_node;
+
+	// a leaf; values live in raw storage and only [0, count) are constructed;
+	template <class Val, std::size_t N>
+	struct btree_node
+	{
+		typedef ft::aligned_buffer<Val, N>	slot_storage;
+
+		btree_node<Val, N>*	parent;
+		unsigned short		position;
+		unsigned short		count;
+		bool				leaf;
+		slot_storage		storage;
+
+		Val*				slot(std::size_t i) {
+			return reinterpret_cast<Val*>(storage.bytes) + i;
+		}
+
+		btree_node<Val, N>*&	child(std::size_t i) {
+			return static_cast<btree_internal_node<Val, N>*>(this)->children[i];
+		}
+	};
+
+	template <class Val, std::size_t N>
+	struct btree_internal_node : public btree_node<Val, N>
+	{
+		btree_node<Val, N>*	children[N + 1];
+	};
+
+	// a slot in a node; end() is one past the last slot of the rightmost leaf;
+	template <class Node, class Val, class Ref, class Ptr>
+	struct btree_iterator
+	{
+		typedef std::bidirectional_iterator_tag					iterator_category;
+		typedef ptrdiff_t										difference_type;
+		typedef Val												value_type;
+		typedef Ref												reference;
+		typedef Ptr												pointer;
+		typedef btree_iterator<Node, Val, Val&, Val*>			iterator;
+		typedef btree_iterator<Node, Val, const Val&, const Val*>	const_iterator;
+		typedef btree_iterator<Node, Val, Ref, Ptr>				self;
+
+		Node*	node;
+		int		position;
+
+		void	increment() {
+			if (node->leaf && ++position < node->count) {
+				return ;
+			}
+			if (node->leaf) {
+				self	save = *this;
+				while (position == node->count && node->parent != 0) {
+					position = node->position;
+					node = node->parent;
+				}
+				if (position == node->count) {
+					*this = save;
+				}
+			} else {
+				node = node->child(position + 1);
+				while (!node->leaf) {
+					node = node->child(0);
+				}
+				position = 0;
+			}
+		}
+
+		void	decrement() {
+			if (node->leaf && --position >= 0) {
+				return ;
+			}
+			if (node->leaf) {
+				self	save = *this;
+				while (position < 0 && node->parent != 0) {
+					position = node->position - 1;
+					node = node->parent;
+				}
+				if (position < 0) {
+					*this = save;
+				}
+			} else {
+				node = node->child(position);
+				while (!node->leaf) {
+					node = node->child(node->count);
+				}
+				position = node->count - 1;
+			}
+		}
+
+		btree_iterator() : node(0), position(0) {}
+		btree_iterator(Node* n, int pos) : node(n), position(pos) {}
+		// iterator -> const_iterator; a template, so it never acts as the copy ctor;
+		template <class V>
+		btree_iterator(const btree_iterator<Node, V, V&, V*>& it) : node(it.node), position(it.position) {}
+
+		reference	operator*() const { return *node->slot(position); }
+		pointer		operator->() const { return &(operator*()); }
+		self&		operator++() {
+			increment();
+			return *this;
+		}
+
+		self		operator++(int) {
+			self	tmp = *this;
+			increment();
+			return tmp;
+		}
+
+		self&		operator--() {
+			decrement();
+			return *this;
+		}
+
+		self		operator--(int) {
+			self	tmp = *this;
+			decrement();
+			return tmp;
+		}
+	};
+
+	template <class Node, class Val, class RefL, class PtrL, class RefR, class PtrR>
+	bool	operator==(const btree_iterator<Node, Val, RefL, PtrL>& x, const btree_iterator<Node, Val, RefR, PtrR>& y) {
+		return x.node == y.node && x.position == y.position;
+	}
+
+	template <class Node, class Val, class RefL, class PtrL, class RefR, class PtrR>
+	bool	operator!=(const btree_iterator<Node, Val, RefL, PtrL>& x, const btree_iterator<Node, Val, RefR, PtrR>& y) {
+		return !(x == y);
+	}
+
+	// B-tree with values in every node, sized so that a node spans a few
+	// cache lines and is searched with a binary search. Values move between
+	// slots as nodes split and merge, so insert and erase invalidate
+	// iterators, and value copies made while shifting must not throw.
+	// Insert hints are taken but not used, so a hinted insert still costs
+	// a full descent; range erase drops a run of slots in one leaf at once
+	// and descends again once per run, not once per element;
+	template <class Key, class Val, class KeyOfVal, class Compare, class Alloc, std::size_t TargetNodeSize = 256>
+	class btree {
+	public:
+		typedef Key																key_type;
+		typedef Val																value_type;
+		typedef value_type*														pointer;
+		typedef const value_type*												const_pointer;
+		typedef value_type&														reference;
+		typedef const value_type&												const_reference;
+		typedef size_t															size_type;
+		typedef ptrdiff_t														difference_type;
+		typedef Alloc															allocator_type;
+
+		static const size_type	node_slots = btree_slots<Val, TargetNodeSize>::value;
+
+	protected:
+		typedef btree_node<Val, node_slots>										node_type;
+		typedef btree_internal_node<Val, node_slots>							internal_node_type;
+		typedef typename Alloc::template rebind<node_type>::other				leaf_allocator_type;
+		typedef typename Alloc::template rebind<internal_node_type>::other		internal_allocator_type;
+
+		static const int	min_slots = (node_slots - 1) / 2;
+
+	public:
+		typedef btree_iterator<node_type, value_type, reference, pointer>				iterator;
+		typedef btree_iterator<node_type, value_type, const_reference, const_pointer>	const_iterator;
+		typedef ft::reverse_iterator<iterator>											reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>									const_reverse_iterator;
+
+	protected:
+		allocator_type			data_allocator;
+		leaf_allocator_type		leaf_allocator;
+		internal_allocator_type	internal_allocator;
+		node_type*				root;
+		node_type*				leftmost;
+		node_type*				rightmost;
+		size_type				element_count;
+		Compare					key_compare;
+
+		node_type*	new_leaf() {
+			node_type*	n = leaf_allocator.allocate(1);
+			n->parent = 0;
+			n->position = 0;
+			n->count = 0;
+			n->leaf = true;
+			return n;
+		}
+
+		node_type*	new_internal() {
+			node_type*	n = internal_allocator.allocate(1);
+			n->parent = 0;
+			n->position = 0;
+			n->count = 0;
+			n->leaf = false;
+			return n;
+		}
+
+		void		free_node(node_type* n) {
+			if (n->leaf) {
+				leaf_allocator.deallocate(n, 1);
+			} else {
+				internal_allocator.deallocate(static_cast<internal_node_type*>(n), 1);
+			}
+		}
+
+		static const Key&	s_key(node_type* n, int i) {
+			return KeyOfVal()(*n->slot(i));
+		}
+
+		static void	set_child(node_type* n, int i, node_type* c) {
+			n->child(i) = c;
+			c->parent = n;
+			c->position = i;
+		}
+
+		void		move_slot(node_type* dst, int dst_i, node_type* src, int src_i) {
+#if __cplusplus >= 201103L
+			std::allocator_traits<allocator_type>::construct(data_allocator, dst->slot(dst_i), std::move(*src->slot(src_i)));
+#else
+			data_allocator.construct(dst->slot(dst_i), *src->slot(src_i));
+#endif
+			data_allocator.destroy(src->slot(src_i));
+		}
+
+		// opens slot i; n->count is left for the caller;
+		void		shift_slots_right(node_type* n, int i) {
+			for (int j = n->count; j > i; --j) {
+				move_slot(n, j, n, j - 1);
+			}
+		}
+
+		// closes the vacated slot i; n->count is left for the caller;
+		void		shift_slots_left(node_type* n, int i) {
+			for (int j = i; j + 1 < n->count; ++j) {
+				move_slot(n, j, n, j + 1);
+			}
+		}
+
+		// opens child i of an internal node holding n->count slots;
+		static void	shift_children_right(node_type* n, int i) {
+			for (int j = n->count + 1; j > i; --j) {
+				set_child(n, j, n->child(j - 1));
+			}
+		}
+
+		int			lower_index(node_type* n, const key_type& k) const {
+			int	lo = 0;
+			int	hi = n->count;
+
+			while (lo < hi) {
+				int	mid = (lo + hi) / 2;
+				if (key_compare(s_key(n, mid), k)) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		int			upper_index(node_type* n, const key_type& k) const {
+			int	lo = 0;
+			int	hi = n->count;
+
+			while (lo < hi) {
+				int	mid = (lo + hi) / 2;
+				if (key_compare(k, s_key(n, mid))) {
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo;
+		}
+
+	public:
+		btree()
+		: data_allocator(allocator_type()), leaf_allocator(data_allocator), internal_allocator(data_allocator), \
+		root(0), leftmost(0), rightmost(0), element_count(0), key_compare() {}
+
+		btree(const Compare& comp, const allocator_type& a)
+		: data_allocator(a), leaf_allocator(data_allocator), internal_allocator(data_allocator), \
+		root(0), leftmost(0), rightmost(0), element_count(0), key_compare(comp) {}
+
+		btree(const btree& x)
+		: data_allocator(x.data_allocator), leaf_allocator(data_allocator), internal_allocator(data_allocator), \
+		root(0), leftmost(0), rightmost(0), element_count(0), key_compare(x.key_compare) {
+			try
+			{
+				insert(x.begin(), x.end());
+			}
+			catch(...)
+			{
+				clear();
+				throw;
+			}
+		}
+
+#if __cplusplus >= 201103L
+		btree(btree&& x)
+		: data_allocator(x.data_allocator), leaf_allocator(x.leaf_allocator), internal_allocator(x.internal_allocator), \
+		root(0), leftmost(0), rightmost(0), element_count(0), key_compare(x.key_compare) {
+			swap(x);
+		}
+#endif
+
+		~btree() {
+			clear();
+		}
+
+		btree&	operator=(const btree& x) {
+			if (this != &x) {
+				clear();
+				key_compare = x.key_compare;
+				insert(x.begin(), x.end());
+			}
+			return *this;
+		}
+
+#if __cplusplus >= 201103L
+		btree&	operator=(btree&& x) {
+			if (this != &x) {
+				clear();
+				swap(x);
+			}
+			return *this;
+		}
+#endif
+
+		// Accessors;
+		Compare	key_comp() const {
+			return key_compare;
+		}
+
+		allocator_type	get_allocator() const {
+			return data_allocator;
+		}
+
+		iterator	begin() {
+			return iterator(leftmost, 0);
+		}
+
+		const_iterator	begin() const {
+			return const_iterator(leftmost, 0);
+		}
+
+		iterator	end() {
+			return iterator(rightmost, rightmost ? rightmost->count : 0);
+		}
+
+		const_iterator	end() const {
+			return const_iterator(rightmost, rightmost ? rightmost->count : 0);
+		}
+
+		reverse_iterator	rbegin() {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator	rbegin() const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator	rend() {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator	rend() const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool	empty() const {
+			return element_count == 0;
+		}
+
+		size_type	size() const {
+			return element_count;
+		}
+
+		size_type	max_size() const {
+			return std::min<size_type>(data_allocator.max_size(), std::numeric_limits<difference_type>::max());
+		}
+
+		void	swap(btree& t) {
+			std::swap(data_allocator, t.data_allocator);
+			std::swap(leaf_allocator, t.leaf_allocator);
+			std::swap(internal_allocator, t.internal_allocator);
+			std::swap(root, t.root);
+			std::swap(leftmost, t.leftmost);
+			std::swap(rightmost, t.rightmost);
+			std::swap(element_count, t.element_count);
+			std::swap(key_compare, t.key_compare);
+		}
+
+		// Insert/Erase;
+		ft::pair<iterator, bool>	insert(const value_type& v) {
+			node_type*	n;
+			int			i;
+
+			if (locate_for_insert(KeyOfVal()(v), n, i)) {
+				return ft::pair<iterator, bool>(iterator(n, i), false);
+			}
+			shift_slots_right(n, i);
+			try
+			{
+				data_allocator.construct(n->slot(i), v);
+			}
+			catch(...)
+			{
+				for (int j = i; j < n->count; ++j) {
+					move_slot(n, j, n, j + 1);
+				}
+				throw;
+			}
+			++n->count;
+			++element_count;
+			return ft::pair<iterator, bool>(iterator(n, i), true);
+		}
+
+		// the hint is not used: a descent costs only a few node visits;
+		iterator	insert(const_iterator, const value_type& v) {
+			return insert(v).first;
+		}
+
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool>	insert(value_type&& v) {
+			node_type*	n;
+			int			i;
+
+			if (locate_for_insert(KeyOfVal()(v), n, i)) {
+				return ft::pair<iterator, bool>(iterator(n, i), false);
+			}
+			shift_slots_right(n, i);
+			try
+			{
+				std::allocator_traits<allocator_type>::construct(data_allocator, n->slot(i), std::move(v));
+			}
+			catch(...)
+			{
+				for (int j = i; j < n->count; ++j) {
+					move_slot(n, j, n, j + 1);
+				}
+				throw;
+			}
+			++n->count;
+			++element_count;
+			return ft::pair<iterator, bool>(iterator(n, i), true);
+		}
+
+		iterator	insert(const_iterator, value_type&& v) {
+			return insert(std::move(v)).first;
+		}
+
+		template <class... Args>
+		ft::pair<iterator, bool>	emplace(Args&&... args) {
+			return insert(value_type(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		iterator	emplace_hint(const_iterator, Args&&... args) {
+			return insert(value_type(std::forward<Args>(args)...)).first;
+		}
+#endif
+
+		template<class InputIterator>
+		void		insert(InputIterator first, InputIterator last) {
+			for (; first != last; ++first) {
+				insert(*first);
+			}
+		}
+
+		void		erase(const_iterator position) {
+			node_type*	n = position.node;
+			int			i = position.position;
+
+			data_allocator.destroy(n->slot(i));
+			if (!n->leaf) {
+				// refill from the predecessor, which always sits in a leaf;
+				node_type*	l = n->child(i);
+				while (!l->leaf) {
+					l = l->child(l->count);
+				}
+				move_slot(n, i, l, l->count - 1);
+				n = l;
+			} else {
+				shift_slots_left(n, i);
+			}
+			--n->count;
+			--element_count;
+			rebalance(n);
+		}
+
+		size_type	erase(const key_type& k) {
+			iterator	it = find(k);
+			if (it == end()) {
+				return 0;
+			}
+			erase(it);
+			return 1;
+		}
+
+		// the rest of the range in first's leaf goes in one pass, a slot in
+		// an internal node goes alone; either may move the slots after it,
+		// so the walk resumes from the next key instead of the next iterator;
+		void		erase(const_iterator first, const_iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return ;
+			}
+			size_type	n = ft::distance(first, last);
+			while (n > 0) {
+				node_type*	x = first.node;
+				const int	i = first.position;
+				const int	run = x->leaf ? static_cast<int>(std::min<size_type>(n, x->count - i)) : 1;
+
+				n -= run;
+				if (n == 0) {
+					erase_run(x, i, run);
+					return ;
+				}
+				const_iterator	next(x, i + run - 1);
+				++next;
+				key_type	k = KeyOfVal()(*next);
+				erase_run(x, i, run);
+				first = lower_bound(k);
+			}
+		}
+
+		void		clear() {
+			if (root != 0) {
+				destroy_subtree(root);
+				root = 0;
+				leftmost = 0;
+				rightmost = 0;
+				element_count = 0;
+			}
+		}
+
+		iterator		find(const key_type& k) {
+			const_iterator	it = static_cast<const btree&>(*this).find(k);
+			return iterator(it.node, it.position);
+		}
+
+		const_iterator	find(const key_type& k) const {
+			node_type*	n = root;
+
+			while (n != 0) {
+				int	i = lower_index(n, k);
+				if (i < n->count && !key_compare(k, s_key(n, i))) {
+					return const_iterator(n, i);
+				}
+				if (n->leaf) {
+					break ;
+				}
+				n = n->child(i);
+			}
+			return end();
+		}
+
+		size_type		count(const key_type& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+
+		iterator		lower_bound(const key_type& k) {
+			const_iterator	it = static_cast<const btree&>(*this).lower_bound(k);
+			return iterator(it.node, it.position);
+		}
+
+		// the deepest slot not less than k is the first one in order;
+		const_iterator	lower_bound(const key_type& k) const {
+			node_type*		n = root;
+			const_iterator	y = end();
+
+			while (n != 0) {
+				int	i = lower_index(n, k);
+				if (i < n->count) {
+					y = const_iterator(n, i);
+				}
+				if (n->leaf) {
+					break ;
+				}
+				n = n->child(i);
+			}
+			return y;
+		}
+
+		iterator		upper_bound(const key_type& k) {
+			const_iterator	it = static_cast<const btree&>(*this).upper_bound(k);
+			return iterator(it.node, it.position);
+		}
+
+		const_iterator	upper_bound(const key_type& k) const {
+			node_type*		n = root;
+			const_iterator	y = end();
+
+			while (n != 0) {
+				int	i = upper_index(n, k);
+				if (i < n->count) {
+					y = const_iterator(n, i);
+				}
+				if (n->leaf) {
+					break ;
+				}
+				n = n->child(i);
+			}
+			return y;
+		}
+
+		ft::pair<iterator, iterator>	equal_range(const key_type& k) {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+
+	private:
+		// finds k, or the leaf slot it belongs in after splitting any full
+		// leaf on the way; true if k is already present;
+		bool		locate_for_insert(const key_type& k, node_type*& n, int& i) {
+			if (root == 0) {
+				root = new_leaf();
+				leftmost = root;
+				rightmost = root;
+			}
+			for (;;) {
+				n = root;
+				for (;;) {
+					i = lower_index(n, k);
+					if (i < n->count && !key_compare(k, s_key(n, i))) {
+						return true;
+					}
+					if (n->leaf) {
+						break ;
+					}
+					n = n->child(i);
+				}
+				if (n->count < node_slots) {
+					return false;
+				}
+				split(n);
+			}
+		}
+
+		// n is full: its middle slot moves up into the parent, splitting
+		// that first if needed, and the upper half moves to a new sibling;
+		void		split(node_type* n) {
+			if (n == root) {
+				node_type*	r = new_internal();
+				set_child(r, 0, n);
+				r->parent = 0;
+				root = r;
+			}
+			if (n->parent->count == node_slots) {
+				split(n->parent);
+			}
+			node_type*	p = n->parent;
+			node_type*	s = n->leaf ? new_leaf() : new_internal();
+			const int	mid = node_slots / 2;
+			const int	pos = n->position;
+
+			for (int j = mid + 1; j < n->count; ++j) {
+				move_slot(s, j - mid - 1, n, j);
+			}
+			if (!n->leaf) {
+				for (int j = mid + 1; j <= n->count; ++j) {
+					set_child(s, j - mid - 1, n->child(j));
+				}
+			}
+			s->count = n->count - mid - 1;
+			shift_slots_right(p, pos);
+			move_slot(p, pos, n, mid);
+			shift_children_right(p, pos + 1);
+			set_child(p, pos + 1, s);
+			++p->count;
+			n->count = mid;
+			if (n == rightmost) {
+				rightmost = s;
+			}
+		}
+
+		// erase m slots from i on; only a leaf may give up more than one;
+		void		erase_run(node_type* n, int i, int m) {
+			if (!n->leaf) {
+				erase(const_iterator(n, i));
+				return ;
+			}
+			for (int j = i; j < i + m; ++j) {
+				data_allocator.destroy(n->slot(j));
+			}
+			for (int j = i + m; j < n->count; ++j) {
+				move_slot(n, j - m, n, j);
+			}
+			n->count -= m;
+			element_count -= m;
+			rebalance(n);
+		}
+
+		// restore the minimum fill of n and its ancestors after an erase;
+		// a leaf that lost a whole run may need several borrows or a merge;
+		void		rebalance(node_type* n) {
+			while (n != root && n->count < min_slots) {
+				node_type*	p = n->parent;
+				const int	idx = n->position;
+				node_type*	l = idx > 0 ? p->child(idx - 1) : 0;
+				node_type*	r = idx < p->count ? p->child(idx + 1) : 0;
+
+				if (l != 0 && l->count > min_slots) {
+					rotate_right(l, n, p, idx - 1);
+					continue ;
+				}
+				if (r != 0 && r->count > min_slots) {
+					rotate_left(n, r, p, idx);
+					continue ;
+				}
+				if (l != 0) {
+					merge(l, n, p, idx - 1);
+				} else {
+					merge(n, r, p, idx);
+				}
+				n = p;
+			}
+			if (root->count == 0) {
+				node_type*	old = root;
+				if (root->leaf) {
+					root = 0;
+					leftmost = 0;
+					rightmost = 0;
+				} else {
+					root = root->child(0);
+					root->parent = 0;
+					root->position = 0;
+				}
+				free_node(old);
+			}
+		}
+
+		// borrow through separator s from the left sibling l;
+		void		rotate_right(node_type* l, node_type* n, node_type* p, int s) {
+			shift_slots_right(n, 0);
+			move_slot(n, 0, p, s);
+			move_slot(p, s, l, l->count - 1);
+			if (!n->leaf) {
+				shift_children_right(n, 0);
+				set_child(n, 0, l->child(l->count));
+			}
+			++n->count;
+			--l->count;
+		}
+
+		// borrow through separator s from the right sibling r;
+		void		rotate_left(node_type* n, node_type* r, node_type* p, int s) {
+			move_slot(n, n->count, p, s);
+			move_slot(p, s, r, 0);
+			shift_slots_left(r, 0);
+			if (!n->leaf) {
+				set_child(n, n->count + 1, r->child(0));
+				for (int j = 0; j < r->count; ++j) {
+					set_child(r, j, r->child(j + 1));
+				}
+			}
+			++n->count;
+			--r->count;
+		}
+
+		// fold separator s and all of r into l, then drop r;
+		void		merge(node_type* l, node_type* r, node_type* p, int s) {
+			move_slot(l, l->count, p, s);
+			for (int j = 0; j < r->count; ++j) {
+				move_slot(l, l->count + 1 + j, r, j);
+			}
+			if (!l->leaf) {
+				for (int j = 0; j <= r->count; ++j) {
+					set_child(l, l->count + 1 + j, r->child(j));
+				}
+			}
+			l->count += 1 + r->count;
+			shift_slots_left(p, s);
+			for (int j = s + 1; j < p->count; ++j) {
+				set_child(p, j, p->child(j + 1));
+			}
+			--p->count;
+			if (r == rightmost) {
+				rightmost = l;
+			}
+			free_node(r);
+		}
+
+		void		destroy_subtree(node_type* n) {
+			if (!n->leaf) {
+				for (int j = 0; j <= n->count; ++j) {
+					destroy_subtree(n->child(j));
+				}
+			}
+			for (int j = 0; j < n->count; ++j) {
+				data_allocator.destroy(n->slot(j));
+			}
+			free_node(n);
+		}
+	};
+
+	// Operator Overloading;
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, std::size_t _N>
+	bool	operator==(const btree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _N>& x, \
+	const btree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _N>& y) {
+		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, std::size_t _N>
+	bool	operator<(const btree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _N>& x, \
+	const btree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _N>& y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef BTREE_MAP_HPP
+#define BTREE_MAP_HPP
+
+#include "btree.hpp"
+#include "map.hpp"
+
+namespace ft
+{
+
+template <class Key, class T, class Compare = std::less<Key>, \
+typename Alloc = std::allocator<ft::pair<const Key, T> > >
+class btree_map
+{
+public:
+	typedef Key						key_type;
+	typedef T						data_type;
+	typedef T						mapped_type;
+	typedef ft::pair<const Key, T>	value_type;
+	typedef Compare					key_compare;
+
+private:
+	typedef ft::btree<key_type, value_type, \
+	SelectFirst<value_type>, key_compare, Alloc>	btree_type;
+	btree_type	tree;
+public:
+	typedef typename btree_type::pointer					pointer;
+	typedef typename btree_type::const_pointer				const_pointer;
+	typedef typename btree_type::reference					reference;
+	typedef typename btree_type::const_reference			const_reference;
+	typedef typename btree_type::iterator					iterator;
+	typedef typename btree_type::const_iterator			const_iterator;
+	typedef typename btree_type::reverse_iterator			reverse_iterator;
+	typedef typename btree_type::const_reverse_iterator	const_reverse_iterator;
+	typedef typename btree_type::size_type					size_type;
+	typedef typename btree_type::difference_type			difference_type;
+	typedef typename btree_type::allocator_type			allocator_type;
+
+	class value_compare {
+		friend class btree_map<Key, T, Compare, Alloc>;
+		protected:
+			Compare	comp;
+			value_compare(Compare c)
+			: comp(c) {}
+		public:
+			typedef value_type	first_argument_type;
+			typedef value_type	second_argument_type;
+			typedef bool		result_type;
+
+			bool	operator()(const value_type& x, const value_type& y) const {
+				return comp(x.first, y.first);
+			}
+	};
+
+	// Construct, Destruct, Copy Assignment Operator Overload
+	explicit btree_map(const Compare& comp = Compare(), const allocator_type& a = allocator_type())
+	: tree(comp, a) {}
+
+	template<class InputIterator>
+	btree_map(InputIterator first, InputIterator last, const Compare& comp = Compare(), \
+	const allocator_type& a = allocator_type())
+	: tree(comp, a) {
+		tree.insert(first, last);
+	}
+
+	btree_map(const btree_map& x)
+	: tree(x.tree) {}
+
+	btree_map<Key, T, Compare, Alloc>&	operator=(const btree_map<Key, T, Compare, Alloc>& x) {
+		tree = x.tree;
+		return *this;
+	}
+
+#if __cplusplus >= 201103L
+	btree_map(btree_map&& x)
+	: tree(std::move(x.tree)) {}
+
+	btree_map<Key, T, Compare, Alloc>&	operator=(btree_map<Key, T, Compare, Alloc>&& x) {
+		tree = std::move(x.tree);
+		return *this;
+	}
+#endif
+
+	~btree_map() {
+		clear();
+	}
+
+	// Accessors
+
+	key_compare	key_comp() const {
+		return tree.key_comp();
+	}
+
+	value_compare	value_comp() const {
+		return value_compare(tree.key_comp());
+	}
+
+	allocator_type	get_allocator() const {
+		return tree.get_allocator();
+	}
+
+	iterator	begin() {
+		return tree.begin();
+	}
+
+	const_iterator	begin() const {
+		return tree.begin();
+	}
+
+	iterator	end() {
+		return tree.end();
+	}
+
+	const_iterator	end() const {
+		return tree.end();
+	}
+
+	reverse_iterator	rbegin() {
+		return tree.rbegin();
+	}
+
+	const_reverse_iterator	rbegin() const {
+		return tree.rbegin();
+	}
+
+	reverse_iterator	rend() {
+		return tree.rend();
+	}
+
+	const_reverse_iterator	rend() const {
+		return tree.rend();
+	}
+
+	bool	empty() const {
+		return tree.empty();
+	}
+
+	size_type	size() const {
+		return tree.size();
+	}
+
+	size_type	max_size() const {
+		return tree.max_size();
+	}
+
+	T&	operator[](const key_type& k) {
+		iterator	i = lower_bound(k);
+		if (i == end() || key_comp()(k, (*i).first)) {
+#if __cplusplus >= 201103L
+			i = tree.emplace_hint(i, k, T());
+#else
+			i = insert(i, value_type(k, T()));
+#endif
+		}
+		return (*i).second;
+	}
+
+#if __cplusplus >= 201103L
+	T&	operator[](key_type&& k) {
+		iterator	i = lower_bound(k);
+		if (i == end() || key_comp()(k, (*i).first)) {
+			i = tree.emplace_hint(i, std::move(k), T());
+		}
+		return (*i).second;
+	}
+#endif
+
+	void	swap(btree_map<Key, T, Compare, Alloc>& x) {
+		tree.swap(x.tree);
+	}
+
+	// insert / erase
+	ft::pair<iterator, bool>	insert(const value_type& x) {
+		return tree.insert(x);
+	}
+
+	iterator	insert(iterator position, const value_type& x) {
+		return tree.insert(position, x);
+	}
+
+#if __cplusplus >= 201103L
+	ft::pair<iterator, bool>	insert(value_type&& x) {
+		return tree.insert(std::move(x));
+	}
+
+	iterator	insert(iterator position, value_type&& x) {
+		return tree.insert(position, std::move(x));
+	}
+
+	template <class... Args>
+	ft::pair<iterator, bool>	emplace(Args&&... args) {
+		return tree.emplace(std::forward<Args>(args)...);
+	}
+
+	template <class... Args>
+	iterator	emplace_hint(iterator position, Args&&... args) {
+		return tree.emplace_hint(position, std::forward<Args>(args)...);
+	}
+#endif
+
+	template<class InputIterator>
+	void	insert(InputIterator first, InputIterator last) {
+		tree.insert(first, last);
+	}
+
+	void	erase(iterator position) {
+		tree.erase(position);
+	}
+
+	size_type	erase(const key_type& x) {
+		return tree.erase(x);
+	}
+
+	void	erase(iterator first, iterator last) {
+		tree.erase(first, last);
+	}
+
+	void	clear() {
+		tree.clear();
+	}
+
+	iterator	find(const key_type& x) {
+		return tree.find(x);
+	}
+
+	const_iterator	find(const key_type& x) const {
+		return tree.find(x);
+	}
+
+	size_type	count(const key_type& x) const {
+		if (tree.find(x) == tree.end()) {
+			return 0;
+		} else {
+			return 1;
+		}
+	}
+
+	iterator	lower_bound(const key_type& x) {
+		return tree.lower_bound(x);
+	}
+
+	const_iterator	lower_bound(const key_type& x) const {
+		return tree.lower_bound(x);
+	}
+
+	iterator	upper_bound(const key_type& x) {
+		return tree.upper_bound(x);
+	}
+
+	const_iterator	upper_bound(const key_type& x) const {
+		return tree.upper_bound(x);
+	}
+
+	ft::pair<iterator, iterator>	equal_range(const key_type& x) {
+		return tree.equal_range(x);
+	}
+
+	ft::pair<const_iterator, const_iterator>	equal_range(const key_type& x) const {
+		return tree.equal_range(x);
+	}
+
+	template<class K1, class T1, class C1, class A1>
+	friend bool	operator==(const btree_map<K1, T1, C1, A1>&, const btree_map<K1, T1, C1, A1>&);
+	template<class K1, class T1, class C1, class A1>
+	friend bool	operator<(const btree_map<K1, T1, C1, A1>&, const btree_map<K1, T1, C1, A1>&);
+};
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator==(const btree_map<Key, T, Compare, Alloc>& x,
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return x.tree == y.tree;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator<(const btree_map<Key, T, Compare, Alloc>& x, \
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return x.tree < y.tree;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator!=(const btree_map<Key, T, Compare, Alloc>& x, \
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return !(x == y);
+}
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator>(const btree_map<Key, T, Compare, Alloc>& x, \
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return y < x;
+}
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator<=(const btree_map<Key, T, Compare, Alloc>&x, \
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return !(y < x);
+}
+
+template<class Key, class T, class Compare, class Alloc>
+bool	operator>=(const btree_map<Key, T, Compare, Alloc>& x, \
+const btree_map<Key, T, Compare, Alloc>& y) {
+	return !(x < y);
+}
+
+template<class Key, class T, class Compare, class Alloc>
+void	swap(btree_map<Key, T, Compare, Alloc>& x, btree_map<Key, T, Compare, Alloc>& y) {
+	x.swap(y);
+}
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#include <cstddef>
+#include <algorithm>
+
+namespace ft
+{
+	// every policy answers with a capacity of at least `required` elements;
+	struct growth_double
+	{
+		static std::size_t	next_capacity(std::size_t size, std::size_t required, std::size_t) {
+			return std::max(size * 2, required);
+		}
+	};
+
+	struct growth_golden
+	{
+		static std::size_t	next_capacity(std::size_t size, std::size_t required, std::size_t) {
+			return std::max(size + size / 2, required);
+		}
+	};
+
+	// doubles, then rounds the byte count up to the allocator's size class:
+	// powers of two up to a page, whole pages above that;
+	struct growth_size_class
+	{
+		static std::size_t	next_capacity(std::size_t size, std::size_t required, std::size_t elem_size) {
+			const std::size_t	page = 4096;
+			std::size_t			bytes = std::max(size * 2, required) * elem_size;
+			std::size_t			rounded = 16;
+
+			if (bytes > page) {
+				rounded = (bytes + page - 1) / page * page;
+			} else {
+				while (rounded < bytes) {
+					rounded *= 2;
+				}
+			}
+			return std::max(rounded / elem_size, required);
+		}
+	};
+
+	template <std::size_t Step = 1024>
+	struct growth_chunk
+	{
+		static std::size_t	next_capacity(std::size_t size, std::size_t required, std::size_t) {
+			return std::max(size + Step, (required + Step - 1) / Step * Step);
+		}
+	};
+}
+
+#endif
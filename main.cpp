@@ -3,6 +3,11 @@
 #include "set.hpp"
 #include "stack.hpp"
 #include "vector.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
+#include "pool_allocator.hpp"
+#include "btree_map.hpp"
+#include "btree_set.hpp"
 #include <map>
 #include <set>
 #include <stack>
@@ -10,6 +15,11 @@
 #include <sys/time.h>
 #include <cstdlib>
 #include <unistd.h>
+#include <sstream>
+#include <iterator>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
 
 #define RED "\033[0;31m"
 #define GREEN "\033[0;32m"
@@ -26,12 +36,238 @@
 #define STACK_SIZE 1000
 #define MAP_SIZE 100
 #define SET_SIZE 100
+#define POD_SIZE 100000
+
+struct NonTrivialInt
+{
+	int	value;
+
+	NonTrivialInt(int v = 0) : value(v) {}
+	NonTrivialInt(const NonTrivialInt& x) : value(x.value) {}
+	NonTrivialInt& operator=(const NonTrivialInt& x) { value = x.value; return *this; }
+	~NonTrivialInt() {}
+};
 
 size_t get_time(timeval start, timeval end)
 {
 	return ((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec));
 }
 
+#define GROWTH_SIZE 1000000
+#define RELOC_SIZE 100000
+#define SMALL_COUNT 100000
+#define DECODE_SIZE 1000000
+#define BAG_SIZE 1000000
+#define STREAM_SIZE 1000000
+#define FRAME_COUNT 100000
+#define NEST_SIZE 100000
+#define POOL_SIZE 1000000
+#define BULK_SIZE 10000000
+#define LOOKUP_SIZE 5000000
+#define BTREE_SIZE 1000000
+#define RANK_SIZE 50000
+#define RANK_QUERIES 100
+#define AGG_SIZE 100000
+#define AGG_QUERIES 200
+#define PROBE_KEYS 10000
+#define PROBE_COUNT 1000000
+#define MIGRATE_SIZE 1000000
+#define SPLIT_SIZE 1000000
+#define ALGEBRA_SIZE 500000
+#define ALGEBRA_SMALL 1000
+#define EXPIRE_SIZE 2000000
+#define EXPIRE_STEP 100000
+#define SCAN_SIZE 1000000
+#define SCAN_PASSES 10
+#define BATCH_QUERIES 1000000
+
+struct HeapInt
+{
+	int*	value;
+
+	HeapInt(int v = 0) : value(new int(v)) {}
+	HeapInt(const HeapInt& x) : value(new int(*x.value)) {}
+	HeapInt& operator=(const HeapInt& x) { *value = *x.value; return *this; }
+	~HeapInt() { delete value; }
+};
+
+struct RelocatableHeapInt : public HeapInt
+{
+	RelocatableHeapInt(int v = 0) : HeapInt(v) {}
+};
+
+namespace ft
+{
+	template <>
+	struct is_trivially_relocatable<RelocatableHeapInt> : public true_type {};
+}
+
+/* push_back GROWTH_SIZE ints; peak_bytes is old + new buffer at the worst reallocation */
+template <class Growth>
+size_t growth_push_back(size_t& peak_bytes)
+{
+	timeval	start;
+	timeval	end;
+
+	peak_bytes = 0;
+	gettimeofday(&start, NULL);
+	{
+		ft::vector<int, std::allocator<int>, Growth> vector_int;
+		size_t	capacity = 0;
+		for (int i = 0; i < GROWTH_SIZE; i++)
+		{
+			vector_int.push_back(i);
+			if (vector_int.capacity() != capacity)
+			{
+				peak_bytes = std::max(peak_bytes, (capacity + vector_int.capacity()) * sizeof(int));
+				capacity = vector_int.capacity();
+			}
+		}
+	}
+	gettimeofday(&end, NULL);
+	return get_time(start, end);
+}
+
+bool is_evicted(int x)
+{
+	return x % 100 == 0;
+}
+
+/* rb_tree_node before the links moved ahead of the value and the color into the parent word */
+template <class Val>
+struct legacy_rb_tree_node
+{
+	Val					value_field;
+	ft::rb_tree_color	color;
+	void*				parent;
+	void*				left;
+	void*				right;
+};
+
+/* insert POOL_SIZE keys, then erase every other one */
+template <class Map>
+size_t map_churn()
+{
+	timeval	start;
+	timeval	end;
+
+	gettimeofday(&start, NULL);
+	{
+		Map	m;
+		for (int i = 0; i < POOL_SIZE; i++)
+			m[(int)(((long)i * 7919) % POOL_SIZE)] = i;
+		for (int i = 0; i < POOL_SIZE; i += 2)
+			m.erase(i);
+	}
+	gettimeofday(&end, NULL);
+	return get_time(start, end);
+}
+
+/* peak RSS of map_churn<Map>() run alone in a child, as ru_maxrss reports it */
+template <class Map>
+long map_churn_rss()
+{
+	struct rusage	usage;
+	int				status;
+	pid_t			pid = fork();
+
+	if (pid == 0)
+	{
+		map_churn<Map>();
+		_exit(0);
+	}
+	if (pid < 0 || wait4(pid, &status, 0, &usage) < 0)
+		return 0;
+	return usage.ru_maxrss;
+}
+
+/* std::allocator that counts every allocate() call */
+static long	counted_allocations = 0;
+
+template <class T>
+struct counting_allocator : public std::allocator<T>
+{
+	template <class U>
+	struct rebind
+	{
+		typedef counting_allocator<U>	other;
+	};
+
+	counting_allocator() : std::allocator<T>() {}
+	counting_allocator(const counting_allocator& x) : std::allocator<T>(x) {}
+	template <class U>
+	counting_allocator(const counting_allocator<U>&) : std::allocator<T>() {}
+
+	T*	allocate(std::size_t n, const void* = 0)
+	{
+		++counted_allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+/* for_each visitor adding up the mapped values */
+struct sum_second
+{
+	long	sum;
+
+	sum_second() : sum(0) {}
+	void	operator()(const ft::pair<const int, int>& p) { sum += p.second; }
+};
+
+/* an int whose copies start throwing once copies_left counts down to 0; -1 never throws */
+static int	copies_left = -1;
+
+struct FragileInt
+{
+	int	value;
+
+	FragileInt(int v = 0) : value(v) {}
+	FragileInt(const FragileInt& x) : value(x.value)
+	{
+		if (copies_left == 0)
+			throw std::bad_alloc();
+		if (copies_left > 0)
+			--copies_left;
+	}
+	bool	operator<(const FragileInt& x) const { return value < x.value; }
+};
+
+/* asks for more alignment than any fundamental type */
+struct WideInt
+{
+	int	value;
+} __attribute__((__aligned__(64)));
+
+/* ordered by key alone, so equivalent elements can still be told apart by tag */
+struct TaggedInt
+{
+	int	key;
+	int	tag;
+
+	TaggedInt(int k = 0, int t = 0) : key(k), tag(t) {}
+	bool	operator<(const TaggedInt& x) const { return key < x.key; }
+};
+
+/* the tag s holds for key, -1 when absent */
+int tag_of(const ft::set<TaggedInt>& s, int key)
+{
+	ft::set<TaggedInt>::const_iterator	it = s.find(TaggedInt(key));
+	return it == s.end() ? -1 : it->tag;
+}
+
+/* whether an ft map holds the same pairs, in the same order, as a std map */
+template <class FtMap, class StdMap>
+bool same_pairs(const FtMap& x, const StdMap& y)
+{
+	if (x.size() != y.size())
+		return false;
+	typename StdMap::const_iterator	j = y.begin();
+	for (typename FtMap::const_iterator i = x.begin(); i != x.end(); ++i, ++j)
+		if (i->first != j->first || i->second != j->second)
+			return false;
+	return true;
+}
+
 int main(void)
 {
 	timeval ft_start;
@@ -40,6 +276,13 @@ int main(void)
 	timeval std_end;
 	size_t ft_time;
 	size_t std_time;
+	timeval obj_start;
+	timeval obj_end;
+	size_t obj_time;
+	/* forked before the other benchmarks have grown this process's heap */
+	long pool_rss = map_churn_rss<ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > >();
+	long heap_rss = map_churn_rss<ft::map<int, int> >();
+	long std_rss = map_churn_rss<std::map<int, int> >();
 
 	// vector
 	std::cout << CYAN << BOLD << "\n\n------------- vector -------------\n\n" << RESET << std::endl;
@@ -470,416 +713,1633 @@ int main(void)
 	else
 		std::cout << GREEN << BOLD << "ft::vector - modifiers is OK" << RESET << std::endl;
 
-	// STACK TEST
-
-	std::cout << CYAN << BOLD << "\n\n------------- stack -------------\n\n" << RESET << std::endl;
-
-	// stack push
-	std::cout << YELLOW << BOLD << "------------- stack push -------------" << RESET << std::endl;
+// vector trivially copyable reserve
+	std::cout << YELLOW << BOLD << "------------- vector trivially copyable reserve -------------" << RESET << std::endl;
+	/* ft::vector<int> takes the memcpy path */
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::stack<int> stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.push(i);
+		ft::vector<int> vector_int(POD_SIZE, 42);
+		for (int i = 2; i < 10; i++)
+			vector_int.reserve(POD_SIZE * i);
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	/* ft::vector<NonTrivialInt> copies element by element */
+	gettimeofday(&obj_start, NULL);
 	{
-		std::stack<int> std_stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.push(i);
+		ft::vector<NonTrivialInt> vector_obj(POD_SIZE, 42);
+		for (int i = 2; i < 10; i++)
+			vector_obj.reserve(POD_SIZE * i);
 	}
-	gettimeofday(&std_end, NULL);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
-
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
 
-	if (std_time && ft_time > 20 * std_time)
+	std::cout << BLUE << BOLD << "pod :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "obj :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::stack - push is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - trivially copyable reserve is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable reserve is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
 	else
-		std::cout << GREEN << BOLD << "ft::stack - push is OK" << RESET << std::endl;
-
-	// stack pop
-	std::cout << YELLOW << BOLD << "------------- stack pop -------------" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable reserve is OK" << RESET << std::endl;
 
+// vector trivially copyable insert
+	std::cout << YELLOW << BOLD << "------------- vector trivially copyable insert -------------" << RESET << std::endl;
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::stack<int> stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.pop();
+		ft::vector<int> vector_int(POD_SIZE, 42);
+		for (int i = 0; i < 20; i++)
+			vector_int.insert(vector_int.begin() + vector_int.size() / 2, POD_SIZE / 10, i);
 	}
-
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	gettimeofday(&obj_start, NULL);
 	{
-		std::stack<int> std_stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.pop();
+		ft::vector<NonTrivialInt> vector_obj(POD_SIZE, 42);
+		for (int i = 0; i < 20; i++)
+			vector_obj.insert(vector_obj.begin() + vector_obj.size() / 2, POD_SIZE / 10, i);
 	}
-	gettimeofday(&std_end, NULL);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
 
-	if (std_time && ft_time > 20 * std_time)
+	std::cout << BLUE << BOLD << "pod :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "obj :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::stack - pop is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - trivially copyable insert is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable insert is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
 	else
-		std::cout << GREEN << BOLD << "ft::stack - pop is OK" << RESET << std::endl;
-
-	// stack top
-	std::cout << YELLOW << BOLD << "------------- stack top -------------" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable insert is OK" << RESET << std::endl;
 
+// vector trivially copyable erase
+	std::cout << YELLOW << BOLD << "------------- vector trivially copyable erase -------------" << RESET << std::endl;
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::stack<int> stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.top();
+		ft::vector<int> vector_int(POD_SIZE, 42);
+		for (int i = 0; i < 100; i++)
+			vector_int.erase(vector_int.begin(), vector_int.begin() + POD_SIZE / 200);
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	gettimeofday(&obj_start, NULL);
 	{
-		std::stack<int> std_stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.top();
+		ft::vector<NonTrivialInt> vector_obj(POD_SIZE, 42);
+		for (int i = 0; i < 100; i++)
+			vector_obj.erase(vector_obj.begin(), vector_obj.begin() + POD_SIZE / 200);
 	}
-	gettimeofday(&std_end, NULL);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
 
-	if (std_time && ft_time > 20 * std_time)
+	std::cout << BLUE << BOLD << "pod :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "obj :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::stack - top is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - trivially copyable erase is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable erase is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
 	else
-		std::cout << GREEN << BOLD << "ft::stack - top is OK" << RESET << std::endl;
-
-	// stack empty
-	std::cout << YELLOW << BOLD << "------------- stack empty -------------" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::vector - trivially copyable erase is OK" << RESET << std::endl;
 
-	gettimeofday(&ft_start, NULL);
+// vector growth policy
+	std::cout << YELLOW << BOLD << "------------- vector growth policy -------------" << RESET << std::endl;
 	{
-		ft::stack<int> stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.pop();
-		if (!stack_int.empty())
-			std::cout << RED << BOLD << "ft::stack - empty is not OK" << RESET << std::endl;
-	}
-	gettimeofday(&ft_end, NULL);
-	ft_time = get_time(ft_start, ft_end);
+		size_t	peak_bytes;
 
+		ft_time = growth_push_back<ft::growth_double>(peak_bytes);
+		std::cout << BLUE << BOLD << "double     :\t" << ft_time << " us\t" << peak_bytes / 1024 << " KiB peak" << RESET << std::endl;
+		obj_time = growth_push_back<ft::growth_golden>(peak_bytes);
+		std::cout << BLUE << BOLD << "golden     :\t" << obj_time << " us\t" << peak_bytes / 1024 << " KiB peak" << RESET << std::endl;
+		obj_time = growth_push_back<ft::growth_size_class>(peak_bytes);
+		std::cout << BLUE << BOLD << "size class :\t" << obj_time << " us\t" << peak_bytes / 1024 << " KiB peak" << RESET << std::endl;
+		obj_time = growth_push_back<ft::growth_chunk<65536> >(peak_bytes);
+		std::cout << BLUE << BOLD << "chunk      :\t" << obj_time << " us\t" << peak_bytes / 1024 << " KiB peak" << RESET << std::endl;
+	}
 	gettimeofday(&std_start, NULL);
 	{
-		std::stack<int> std_stack_int;
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.pop();
-		if (!std_stack_int.empty())
-			std::cout << RED << BOLD << "std::stack - empty is not OK" << RESET << std::endl;
+		std::vector<int> std_vector_int;
+		for (int i = 0; i < GROWTH_SIZE; i++)
+			std_vector_int.push_back(i);
 	}
 	gettimeofday(&std_end, NULL);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
-
+	std_time = get_time(std_start, std_end);
+	std::cout << MAGENTA << BOLD << "std        :\t" << std_time << " us" << RESET << std::endl;
 	if (std_time && ft_time > 20 * std_time)
 	{
-		std::cout << RED << BOLD << "ft::stack - empty is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - growth policy is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::stack - empty is OK" << RESET << std::endl;
-
-	// stack relational operators
-	std::cout << YELLOW << BOLD << "------------- stack relational operators -------------" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::vector - growth policy is OK" << RESET << std::endl;
 
+// vector trivially relocatable
+	std::cout << YELLOW << BOLD << "------------- vector trivially relocatable -------------" << RESET << std::endl;
+	/* reallocation moves the owned pointers with memcpy */
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::stack<int> stack_int;
-		ft::stack<int> stack_int2;
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			stack_int2.push(i);
-		if (stack_int != stack_int2)
-			std::cout << RED << BOLD << "ft::stack - relational operators is not OK" << RESET << std::endl;
+		ft::vector<RelocatableHeapInt> vector_obj;
+		for (int i = 0; i < RELOC_SIZE; i++)
+			vector_obj.push_back(i);
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	/* reallocation deep copies, then frees the old heap ints */
+	gettimeofday(&obj_start, NULL);
 	{
-		std::stack<int> std_stack_int;
-		std::stack<int> std_stack_int2;
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int.push(i);
-		for (int i = 0; i < STACK_SIZE; i++)
-			std_stack_int2.push(i);
-		if (std_stack_int != std_stack_int2)
-			std::cout << RED << BOLD << "std::stack - relational operators is not OK" << RESET << std::endl;
+		ft::vector<HeapInt> vector_obj;
+		for (int i = 0; i < RELOC_SIZE; i++)
+			vector_obj.push_back(i);
 	}
-	gettimeofday(&std_end, NULL);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
 
-	if (std_time && ft_time > 20 * std_time)
+	std::cout << BLUE << BOLD << "reloc :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "copy  :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::stack - relational operators is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - trivially relocatable is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - trivially relocatable is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
 	else
-		std::cout << GREEN << BOLD << "ft::stack - relational operators is OK" << RESET << std::endl;
-
-	// MAP TEST
+		std::cout << GREEN << BOLD << "ft::vector - trivially relocatable is OK" << RESET << std::endl;
 
-	std::cout << CYAN << BOLD << "\n\n------------- map -------------\n\n" << RESET << std::endl;
-	// map insert
-	std::cout << YELLOW << BOLD << "------------- map insert -------------" << RESET << std::endl;
+// vector realloc growth
+	std::cout << YELLOW << BOLD << "------------- vector realloc growth -------------" << RESET << std::endl;
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::map<int, int> map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.insert(ft::make_pair(i, i));
+		ft::vector<int, ft::malloc_allocator<int> > vector_int;
+		for (int i = 0; i < GROWTH_SIZE; i++)
+			vector_int.push_back(i);
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	gettimeofday(&obj_start, NULL);
 	{
-		std::map<int, int> std_map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.insert(std::make_pair(i, i));
+		ft::vector<int> vector_int;
+		for (int i = 0; i < GROWTH_SIZE; i++)
+			vector_int.push_back(i);
 	}
-	gettimeofday(&std_end, NULL);
-	std_time = get_time(std_start, std_end);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
-	if (std_time && ft_time > 20 * std_time)
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "realloc :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "memcpy  :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::map - insert is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::vector - realloc growth is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::map - insert is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::vector - realloc growth is OK" << RESET << std::endl;
 
-	// map find
-	std::cout << YELLOW << BOLD << "------------- map find -------------" << RESET << std::endl;
+// small_vector short-lived
+	std::cout << YELLOW << BOLD << "------------- small_vector short-lived -------------" << RESET << std::endl;
+	/* ft::small_vector keeps up to 16 ints inline */
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::map<int, int> map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.insert(ft::make_pair(i, i));
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.find(i);
+		long	sum = 0;
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::small_vector<int, 16> small_int;
+			for (int j = 0; j < 12; j++)
+				small_int.push_back(i + j);
+			sum += small_int.back();
+		}
+		(void)sum;
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	/* ft::vector allocates and regrows every time */
+	gettimeofday(&obj_start, NULL);
 	{
-		std::map<int, int> std_map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.insert(std::make_pair(i, i));
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.find(i);
+		long	sum = 0;
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::vector<int> vector_int;
+			for (int j = 0; j < 12; j++)
+				vector_int.push_back(i + j);
+			sum += vector_int.back();
+		}
+		(void)sum;
 	}
-	gettimeofday(&std_end, NULL);
-	std_time = get_time(std_start, std_end);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
-	if (std_time && ft_time > 20 * std_time)
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "small  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "vector :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
 	{
-		std::cout << RED << BOLD << "ft::map - find is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::small_vector - short-lived is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::small_vector - short-lived is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
 	else
-		std::cout << GREEN << BOLD << "ft::map - find is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::small_vector - short-lived is OK" << RESET << std::endl;
 
-	// map erase
-	std::cout << YELLOW << BOLD << "------------- map erase -------------" << RESET << std::endl;
+// small_vector as stack container
+	std::cout << YELLOW << BOLD << "------------- small_vector stack -------------" << RESET << std::endl;
 	gettimeofday(&ft_start, NULL);
 	{
-		ft::map<int, int> map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.insert(ft::make_pair(i, i));
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.erase(i);
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::stack<int, ft::small_vector<int, 16> > stack_int;
+			for (int j = 0; j < 12; j++)
+				stack_int.push(j);
+			while (!stack_int.empty())
+				stack_int.pop();
+		}
 	}
 	gettimeofday(&ft_end, NULL);
 	ft_time = get_time(ft_start, ft_end);
-
-	gettimeofday(&std_start, NULL);
+	gettimeofday(&obj_start, NULL);
 	{
-		std::map<int, int> std_map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.insert(std::make_pair(i, i));
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.erase(i);
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::stack<int> stack_int;
+			for (int j = 0; j < 12; j++)
+				stack_int.push(j);
+			while (!stack_int.empty())
+				stack_int.pop();
+		}
 	}
-	gettimeofday(&std_end, NULL);
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "small  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "vector :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::small_vector - stack is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::small_vector - stack is OK" << RESET << std::endl;
+	{
+		/* from C++11 on spilling to the heap moves the inner buffers instead of copying them */
+		ft::small_vector<ft::vector<int>, 2> nest;
+		nest.push_back(ft::vector<int>(16, 0));
+		nest.push_back(ft::vector<int>(16, 1));
+		const int*	first_data = &nest[0][0];
+		nest.push_back(ft::vector<int>(16, 3));
+		nest.insert(nest.begin() + 2, ft::vector<int>(16, 2));
+#if __cplusplus >= 201103L
+		nest.emplace(nest.begin(), 4, -1);
+#else
+		nest.insert(nest.begin(), ft::vector<int>(4, -1));
+#endif
+		if (nest.is_inline() || nest.size() != 5 || nest[0].size() != 4 || nest[0][0] != -1
+			|| nest[1][0] != 0 || nest[3][0] != 2 || nest[4][0] != 3
+			|| (__cplusplus >= 201103L && &nest[1][0] != first_data))
+		{
+			std::cout << RED << BOLD << "ft::small_vector - spill of vectors is wrong" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::small_vector - spill of vectors is OK" << RESET << std::endl;
+	}
+	{
+		/* a copy constructor that throws gives back its heap buffer; inline room is aligned to T */
+		ft::small_vector<FragileInt, 4> spilled;
+		for (int i = 0; i < 32; i++)
+			spilled.push_back(FragileInt(i));
+		int thrown = 0;
+		copies_left = 16;
+		try { ft::small_vector<FragileInt, 4> copy(spilled); } catch (std::bad_alloc&) { ++thrown; }
+		copies_left = -1;
+		ft::small_vector<WideInt, 3> wide(2);
+		if (thrown != 1 || spilled.size() != 32 || spilled[31].value != 31
+			|| reinterpret_cast<std::size_t>(&wide[0]) % __alignof__(WideInt) != 0)
+		{
+			std::cout << RED << BOLD << "ft::small_vector - throwing copy is wrong" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::small_vector - throwing copy is OK" << RESET << std::endl;
+	}
+
+// static_vector scratch buffer
+	std::cout << YELLOW << BOLD << "------------- static_vector scratch buffer -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		long	sum = 0;
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::static_vector<int, 32> scratch_int;
+			for (int j = 0; j < 24; j++)
+				scratch_int.insert(scratch_int.begin() + j / 2, j);
+			scratch_int.erase(scratch_int.begin(), scratch_int.begin() + 8);
+			sum += scratch_int.front();
+		}
+		(void)sum;
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	gettimeofday(&obj_start, NULL);
+	{
+		long	sum = 0;
+		for (int i = 0; i < SMALL_COUNT; i++)
+		{
+			ft::vector<int> vector_int;
+			for (int j = 0; j < 24; j++)
+				vector_int.insert(vector_int.begin() + j / 2, j);
+			vector_int.erase(vector_int.begin(), vector_int.begin() + 8);
+			sum += vector_int.front();
+		}
+		(void)sum;
+	}
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "static :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "vector :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::static_vector - scratch buffer is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::static_vector - scratch buffer is OK" << RESET << std::endl;
+	{
+		/* an assign() that cannot fit throws before dropping anything */
+		ft::static_vector<int, 4> full(3, 7);
+		int too_many[5] = {1, 2, 3, 4, 5};
+		bool thrown = false;
+		try
+		{
+			full.assign(too_many, too_many + 5);
+		}
+		catch (std::length_error&)
+		{
+			thrown = true;
+		}
+		if (!thrown || full.size() != 3 || full[0] != 7)
+		{
+			std::cout << RED << BOLD << "ft::static_vector - overflowing assign lost the contents" << RESET << std::endl;
+			exit(1);
+		}
+	}
+
+// vector append uninitialized
+	std::cout << YELLOW << BOLD << "------------- vector append uninitialized -------------" << RESET << std::endl;
+	/* decode loop: grow without initializing, then overwrite */
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::vector<int> vector_int;
+		for (int i = 0; i < 10; i++)
+		{
+			vector_int.clear();
+			int*	out = vector_int.append_uninitialized(DECODE_SIZE);
+			for (int j = 0; j < DECODE_SIZE; j += 1024)
+				out[j] = j;
+		}
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	/* same loop through resize(), which writes every slot first */
+	gettimeofday(&obj_start, NULL);
+	{
+		ft::vector<int> vector_int;
+		for (int i = 0; i < 10; i++)
+		{
+			vector_int.clear();
+			vector_int.resize(DECODE_SIZE);
+			int*	out = &vector_int[0];
+			for (int j = 0; j < DECODE_SIZE; j += 1024)
+				out[j] = j;
+		}
+	}
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "append :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "resize :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - append uninitialized is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - append uninitialized is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
+	else
+		std::cout << GREEN << BOLD << "ft::vector - append uninitialized is OK" << RESET << std::endl;
+
+// vector erase_if
+	std::cout << YELLOW << BOLD << "------------- vector erase_if -------------" << RESET << std::endl;
+	/* eviction sweep: one compaction pass */
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::vector<int> vector_int;
+		for (int i = 0; i < POD_SIZE; i++)
+			vector_int.push_back(i);
+		ft::erase_if(vector_int, is_evicted);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	/* eviction sweep: erase() shifts the tail for every victim */
+	gettimeofday(&obj_start, NULL);
+	{
+		ft::vector<int> vector_int;
+		for (int i = 0; i < POD_SIZE; i++)
+			vector_int.push_back(i);
+		for (ft::vector<int>::iterator it = vector_int.begin(); it != vector_int.end(); )
+		{
+			if (is_evicted(*it))
+				it = vector_int.erase(it);
+			else
+				++it;
+		}
+	}
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "erase_if :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "erase    :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - erase_if is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - erase_if is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
+	else
+		std::cout << GREEN << BOLD << "ft::vector - erase_if is OK" << RESET << std::endl;
+
+// vector erase_sorted
+	std::cout << YELLOW << BOLD << "------------- vector erase_sorted -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::vector<int> vector_int;
+		for (int i = 0; i < POD_SIZE; i++)
+			vector_int.push_back(i);
+		ft::vector<ft::vector<int>::iterator> victims;
+		for (int i = 0; i < POD_SIZE; i += 100)
+			victims.push_back(vector_int.begin() + i);
+		vector_int.erase_sorted(victims.begin(), victims.end());
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	std::cout << BLUE << BOLD << "sorted   :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "erase    :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - erase_sorted is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::vector - erase_sorted is OK" << RESET << std::endl;
+
+// vector unordered_erase
+	std::cout << YELLOW << BOLD << "------------- vector unordered_erase -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::vector<int> vector_int(BAG_SIZE, 42);
+		for (int i = 0; i < 1000; i++)
+			vector_int.unordered_erase(vector_int.begin() + (i * 997) % vector_int.size());
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	gettimeofday(&obj_start, NULL);
+	{
+		ft::vector<int> vector_int(BAG_SIZE, 42);
+		for (int i = 0; i < 1000; i++)
+			vector_int.erase(vector_int.begin() + (i * 997) % vector_int.size());
+	}
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "unordered :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "erase     :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - unordered_erase is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - unordered_erase is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
+	else
+		std::cout << GREEN << BOLD << "ft::vector - unordered_erase is OK" << RESET << std::endl;
+
+// vector unordered_erase range
+	std::cout << YELLOW << BOLD << "------------- vector unordered_erase range -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::vector<int> vector_int(BAG_SIZE, 42);
+		for (int i = 0; i < 1000; i++)
+			vector_int.unordered_erase(vector_int.begin() + i * 100, vector_int.begin() + i * 100 + 10);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+	gettimeofday(&obj_start, NULL);
+	{
+		ft::vector<int> vector_int(BAG_SIZE, 42);
+		for (int i = 0; i < 1000; i++)
+			vector_int.erase(vector_int.begin() + i * 100, vector_int.begin() + i * 100 + 10);
+	}
+	gettimeofday(&obj_end, NULL);
+	obj_time = get_time(obj_start, obj_end);
+
+	std::cout << BLUE << BOLD << "unordered :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "erase     :\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - unordered_erase range is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else if (ft_time)
+		std::cout << GREEN << BOLD << "ft::vector - unordered_erase range is " << (double)obj_time / ft_time << " times faster" << RESET << std::endl;
+	else
+		std::cout << GREEN << BOLD << "ft::vector - unordered_erase range is OK" << RESET << std::endl;
+	{
+		/* from C++11 on the back element is moved into the hole, so its buffer changes hands */
+		ft::vector<ft::vector<int> > nest;
+		for (int i = 0; i < 8; i++)
+			nest.push_back(ft::vector<int>(16, i));
+		const int*	back_data = &nest.back()[0];
+		nest.unordered_erase(nest.begin() + 2);
+		nest.erase(nest.begin(), nest.begin() + 1);
+		if (nest.size() != 6 || nest[1][0] != 7 || nest[0][0] != 1
+			|| (__cplusplus >= 201103L && &nest[1][0] != back_data))
+		{
+			std::cout << RED << BOLD << "ft::vector - unordered_erase of vectors is wrong" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::vector - unordered_erase of vectors is OK" << RESET << std::endl;
+	}
+	{
+		/* an empty range erase keeps every element, even where moving one onto itself would not */
+		std::string words[] = {"a", "b", "c"};
+		ft::vector<std::string> v(words, words + 3);
+		ft::small_vector<std::string, 2> sv(words, words + 3);
+		ft::static_vector<std::string, 4> stv(words, words + 3);
+		v.erase(v.begin() + 1, v.begin() + 1);
+		sv.erase(sv.begin() + 1, sv.begin() + 1);
+		stv.erase(stv.begin() + 1, stv.begin() + 1);
+		v.erase(v.begin(), v.begin() + 1);
+		sv.erase(sv.begin(), sv.begin() + 1);
+		stv.erase(stv.begin(), stv.begin() + 1);
+		if (v.size() != 2 || v[0] != "b" || v[1] != "c"
+			|| sv.size() != 2 || sv[0] != "b" || sv[1] != "c"
+			|| stv.size() != 2 || stv[0] != "b" || stv[1] != "c")
+		{
+			std::cout << RED << BOLD << "ft::vector - range erase of strings is wrong" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::vector - range erase of strings is OK" << RESET << std::endl;
+	}
+
+// vector input iterator insert
+	std::cout << YELLOW << BOLD << "------------- vector input iterator insert -------------" << RESET << std::endl;
+	{
+		std::ostringstream	out;
+		for (int i = 0; i < STREAM_SIZE; i++)
+			out << i << ' ';
+		const std::string	stream_data = out.str();
+
+		/* stream into the middle of an existing vector */
+		gettimeofday(&ft_start, NULL);
+		{
+			std::istringstream	in(stream_data);
+			ft::vector<int> vector_int(VEC_SIZE, 42);
+			vector_int.insert(vector_int.begin() + VEC_SIZE / 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&std_start, NULL);
+		{
+			std::istringstream	in(stream_data);
+			std::vector<int> std_vector_int(VEC_SIZE, 42);
+			std_vector_int.insert(std_vector_int.begin() + VEC_SIZE / 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - input iterator insert is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::vector - input iterator insert is OK" << RESET << std::endl;
+
+// vector assign frame reset
+	std::cout << YELLOW << BOLD << "------------- vector assign frame reset -------------" << RESET << std::endl;
+	{
+		ft::vector<NonTrivialInt> frame_src(VEC_SIZE / 10, 7);
+		std::vector<NonTrivialInt> std_frame_src(VEC_SIZE / 10, 7);
+
+		/* assign() copy-assigns into the live elements */
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::vector<NonTrivialInt> frame(VEC_SIZE / 10, 0);
+			for (int i = 0; i < FRAME_COUNT; i++)
+				frame.assign(frame_src.begin(), frame_src.end());
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		/* the old assign(): destroy everything, then copy-construct again */
+		gettimeofday(&obj_start, NULL);
+		{
+			ft::vector<NonTrivialInt> frame(VEC_SIZE / 10, 0);
+			for (int i = 0; i < FRAME_COUNT; i++)
+			{
+				frame.erase(frame.begin(), frame.end());
+				frame.insert(frame.begin(), frame_src.begin(), frame_src.end());
+			}
+		}
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		gettimeofday(&std_start, NULL);
+		{
+			std::vector<NonTrivialInt> std_frame(VEC_SIZE / 10, 0);
+			for (int i = 0; i < FRAME_COUNT; i++)
+				std_frame.assign(std_frame_src.begin(), std_frame_src.end());
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+	}
+	std::cout << BLUE << BOLD << "ft     :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "rebuild:\t" << obj_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std    :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - assign is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::vector - assign is OK" << RESET << std::endl;
+
+// vector of vectors growth
+	std::cout << YELLOW << BOLD << "------------- vector of vectors growth (C++" << (__cplusplus >= 201103L ? "11" : "98") << ") -------------" << RESET << std::endl;
+	{
+		/* every reallocation moves the inner buffers from C++11 on, and deep-copies them before */
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::vector<ft::vector<int> > nest;
+			for (int i = 0; i < NEST_SIZE; i++)
+				nest.push_back(ft::vector<int>(16, i));
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&std_start, NULL);
+		{
+			std::vector<std::vector<int> > std_nest;
+			for (int i = 0; i < NEST_SIZE; i++)
+				std_nest.push_back(std::vector<int>(16, i));
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::vector - nested push_back is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::vector - nested push_back is OK" << RESET << std::endl;
+
+	// STACK TEST
+
+	std::cout << CYAN << BOLD << "\n\n------------- stack -------------\n\n" << RESET << std::endl;
+
+	// stack push
+	std::cout << YELLOW << BOLD << "------------- stack push -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::stack<int> stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.push(i);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::stack<int> std_stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.push(i);
+	}
+	gettimeofday(&std_end, NULL);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+
+
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::stack - push is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::stack - push is OK" << RESET << std::endl;
+
+	// stack pop
+	std::cout << YELLOW << BOLD << "------------- stack pop -------------" << RESET << std::endl;
+
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::stack<int> stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.pop();
+	}
+
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::stack<int> std_stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.pop();
+	}
+	gettimeofday(&std_end, NULL);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::stack - pop is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::stack - pop is OK" << RESET << std::endl;
+
+	// stack top
+	std::cout << YELLOW << BOLD << "------------- stack top -------------" << RESET << std::endl;
+
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::stack<int> stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.top();
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::stack<int> std_stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.top();
+	}
+	gettimeofday(&std_end, NULL);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::stack - top is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::stack - top is OK" << RESET << std::endl;
+
+	// stack empty
+	std::cout << YELLOW << BOLD << "------------- stack empty -------------" << RESET << std::endl;
+
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::stack<int> stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.pop();
+		if (!stack_int.empty())
+			std::cout << RED << BOLD << "ft::stack - empty is not OK" << RESET << std::endl;
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::stack<int> std_stack_int;
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.pop();
+		if (!std_stack_int.empty())
+			std::cout << RED << BOLD << "std::stack - empty is not OK" << RESET << std::endl;
+	}
+	gettimeofday(&std_end, NULL);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::stack - empty is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::stack - empty is OK" << RESET << std::endl;
+
+	// stack relational operators
+	std::cout << YELLOW << BOLD << "------------- stack relational operators -------------" << RESET << std::endl;
+
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::stack<int> stack_int;
+		ft::stack<int> stack_int2;
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			stack_int2.push(i);
+		if (stack_int != stack_int2)
+			std::cout << RED << BOLD << "ft::stack - relational operators is not OK" << RESET << std::endl;
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::stack<int> std_stack_int;
+		std::stack<int> std_stack_int2;
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int.push(i);
+		for (int i = 0; i < STACK_SIZE; i++)
+			std_stack_int2.push(i);
+		if (std_stack_int != std_stack_int2)
+			std::cout << RED << BOLD << "std::stack - relational operators is not OK" << RESET << std::endl;
+	}
+	gettimeofday(&std_end, NULL);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::stack - relational operators is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::stack - relational operators is OK" << RESET << std::endl;
+
+	// MAP TEST
+
+	std::cout << CYAN << BOLD << "\n\n------------- map -------------\n\n" << RESET << std::endl;
+	// map insert
+	std::cout << YELLOW << BOLD << "------------- map insert -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.insert(ft::make_pair(i, i));
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.insert(std::make_pair(i, i));
+	}
+	gettimeofday(&std_end, NULL);
+	std_time = get_time(std_start, std_end);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - insert is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - insert is OK" << RESET << std::endl;
+
+	// map node pool
+	std::cout << YELLOW << BOLD << "------------- map node pool -------------" << RESET << std::endl;
+	{
+		typedef ft::map<int, int>	heap_map;
+		typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > >	pool_map;
+		typedef std::map<int, int>	std_map;
+
+		ft_time = map_churn<pool_map>();
+		obj_time = map_churn<heap_map>();
+		std_time = map_churn<std_map>();
+		std::cout << BLUE << BOLD << "ft pool:\t" << ft_time << " us\t(" << (POOL_SIZE + POOL_SIZE / 2) * 1000 / (ft_time ? ft_time : 1) << " ops/ms, maxrss " << pool_rss << ")" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "ft heap:\t" << obj_time << " us\t(" << (POOL_SIZE + POOL_SIZE / 2) * 1000 / (obj_time ? obj_time : 1) << " ops/ms, maxrss " << heap_rss << ")" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "std    :\t" << std_time << " us\t(" << (POOL_SIZE + POOL_SIZE / 2) * 1000 / (std_time ? std_time : 1) << " ops/ms, maxrss " << std_rss << ")" << RESET << std::endl;
+	}
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - pooled insert/erase is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - pooled insert/erase is OK" << RESET << std::endl;
+	{
+		/* the map's nodes come out of the pool its caller handed in, and a split keeps to it */
+		typedef ft::pool_allocator<ft::pair<const int, int> >					pool_alloc;
+		typedef ft::map<int, int, std::less<int>, pool_alloc>					pool_map;
+		pool_alloc	alloc;
+		pool_map	pooled(std::less<int>(), alloc);
+		for (int i = 0; i < 1000; i++)
+			pooled.insert(ft::make_pair(i, i));
+		pool_map	upper = pooled.split(500);
+		pool_map	copy(upper);
+		if (alloc.reserved_bytes() == 0 || !(pooled.get_allocator() == alloc) || !(upper.get_allocator() == alloc)
+			|| !(copy.get_allocator() == alloc) || pooled.size() != 500 || upper.size() != 500 || copy.begin()->first != 500)
+		{
+			std::cout << RED << BOLD << "ft::map - pool handed in is not shared" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::map - pool handed in is shared" << RESET << std::endl;
+	}
+
+	// map find
+	std::cout << YELLOW << BOLD << "------------- map find -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.insert(ft::make_pair(i, i));
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.find(i);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.insert(std::make_pair(i, i));
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.find(i);
+	}
+	gettimeofday(&std_end, NULL);
+	std_time = get_time(std_start, std_end);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - find is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - find is OK" << RESET << std::endl;
+
+	// map erase
+	std::cout << YELLOW << BOLD << "------------- map erase -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.insert(ft::make_pair(i, i));
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.erase(i);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.insert(std::make_pair(i, i));
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.erase(i);
+	}
+	gettimeofday(&std_end, NULL);
+	std_time = get_time(std_start, std_end);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - erase is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - erase is OK" << RESET << std::endl;
+
+	// map relational operators
+	std::cout << YELLOW << BOLD << "------------- map relational operators -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		ft::map<int, int> map_int2;
+		ft::map<int, int> map_int3;
+		for (int i = 0; i < MAP_SIZE; i++)
+		{
+			map_int.insert(ft::make_pair(i, i));
+			map_int2.insert(ft::make_pair(i, i));
+			map_int3.insert(ft::make_pair(i + 1, i + 1));
+		}
+		if (map_int != map_int2)
+		{
+			std::cout << RED << BOLD << "ft::map - relational operators(==) is not OK" << RESET << std::endl;
+			exit(1);
+		}
+		if (map_int > map_int3)
+		{
+			std::cout << RED << BOLD << "ft::map - relational operators(>) is not OK" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		std::map<int, int> std_map_int2;
+		std::map<int, int> std_map_int3;
+		for (int i = 0; i < MAP_SIZE; i++)
+		{
+			std_map_int.insert(std::make_pair(i, i));
+			std_map_int2.insert(std::make_pair(i, i));
+			std_map_int3.insert(std::make_pair(i + 1, i + 1));
+		}
+		if (std_map_int != std_map_int2)
+		{
+			std::cout << RED << BOLD << "std::map - relational operators(==) is not OK" << RESET << std::endl;
+			exit(1);
+		}
+		if (std_map_int > std_map_int3)
+		{
+			std::cout << RED << BOLD << "std::map - relational operators(>) is not OK" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	gettimeofday(&std_end, NULL);
+	std_time = get_time(std_start, std_end);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - relational operators is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - relational operators is OK" << RESET << std::endl;
+
+	// map swap
+	std::cout << YELLOW << BOLD << "------------- map swap -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		ft::map<int, int> map_int2;
+		for (int i = 0; i < MAP_SIZE; i++)
+		{
+			map_int.insert(ft::make_pair(i, i));
+			map_int2.insert(ft::make_pair(i + 1, i + 1));
+		}
+		map_int.swap(map_int2);
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		std::map<int, int> std_map_int2;
+		for (int i = 0; i < MAP_SIZE; i++)
+		{
+			std_map_int.insert(std::make_pair(i, i));
+			std_map_int2.insert(std::make_pair(i + 1, i + 1));
+		}
+		std_map_int.swap(std_map_int2);
+	}
+	gettimeofday(&std_end, NULL);
+	std_time = get_time(std_start, std_end);
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - swap is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - swap is OK" << RESET << std::endl;
+
+	// map clear
+	std::cout << YELLOW << BOLD << "------------- map clear -------------" << RESET << std::endl;
+	gettimeofday(&ft_start, NULL);
+	{
+		ft::map<int, int> map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			map_int.insert(ft::make_pair(i, i));
+		map_int.clear();
+	}
+	gettimeofday(&ft_end, NULL);
+	ft_time = get_time(ft_start, ft_end);
+
+	gettimeofday(&std_start, NULL);
+	{
+		std::map<int, int> std_map_int;
+		for (int i = 0; i < MAP_SIZE; i++)
+			std_map_int.insert(std::make_pair(i, i));
+		std_map_int.clear();
+	}
+	gettimeofday(&std_end, NULL);
 	std_time = get_time(std_start, std_end);
 	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
 	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
 	if (std_time && ft_time > 20 * std_time)
 	{
-		std::cout << RED << BOLD << "ft::map - erase is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::map - clear is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - clear is OK" << RESET << std::endl;
+
+
+	// map string values
+	std::cout << YELLOW << BOLD << "------------- map string values (C++" << (__cplusplus >= 201103L ? "11" : "98") << ") -------------" << RESET << std::endl;
+	{
+		std::string	payload(64, 'x');
+
+		/* operator[] builds the value in place from C++11 on */
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::map<int, std::string> strings;
+			for (int i = 0; i < NEST_SIZE; i++)
+				strings[i] = payload;
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&std_start, NULL);
+		{
+			std::map<int, std::string> std_strings;
+			for (int i = 0; i < NEST_SIZE; i++)
+				std_strings[i] = payload;
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - string operator[] is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - string operator[] is OK" << RESET << std::endl;
+
+	// map range aggregate
+	std::cout << YELLOW << BOLD << "------------- map range aggregate -------------" << RESET << std::endl;
+	{
+		typedef ft::pair<const int, long> sample;
+		ft::map<int, long, std::less<int>, std::allocator<sample>, ft::rb_tree_monoid_augment<ft::SumSecond<sample> > > series;
+		std::map<int, long> std_series;
+		for (int i = 0; i < AGG_SIZE; i++)
+		{
+			int t = (int)(((long)i * 7919) % AGG_SIZE);
+			series.insert(ft::make_pair(t, (long)(t % 97)));
+			std_series.insert(std::make_pair(t, (long)(t % 97)));
+		}
+
+		/* whole subtrees are summed at once, two root-to-leaf paths per query */
+		long ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < AGG_QUERIES; i++)
+		{
+			int lo = (int)(((long)i * 7919) % AGG_SIZE);
+			ft_sum += series.aggregate(lo, lo + AGG_SIZE / 10);
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < AGG_QUERIES; i++)
+		{
+			int lo = (int)(((long)i * 7919) % AGG_SIZE);
+			std::map<int, long>::iterator last = std_series.lower_bound(lo + AGG_SIZE / 10);
+			for (std::map<int, long>::iterator it = std_series.lower_bound(lo); it != last; ++it)
+				std_sum += it->second;
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum)
+		{
+			std::cout << RED << BOLD << "ft::map - range aggregate disagrees with std::map" << RESET << std::endl;
+			exit(1);
+		}
+
+		/* the totals above a changed value are refolded by update() */
+		ft::map<int, long, std::less<int>, std::allocator<sample>, ft::rb_tree_monoid_augment<ft::SumSecond<sample> > > small;
+		for (int i = 0; i < 100; i++)
+			small[i];
+		for (int i = 0; i < 100; i++)
+			small.update(small.find(i), 1);
+		small.update(small.find(50), 1000);
+		small.update(small.begin(), 500);
+		if (small.aggregate(0, 100) != 1598 || small.aggregate(1, 50) != 49 || small[50] != 1000)
+		{
+			std::cout << RED << BOLD << "ft::map - aggregate is stale after update" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - range aggregate is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - range aggregate is OK" << RESET << std::endl;
+
+	// map heterogeneous lookup
+	std::cout << YELLOW << BOLD << "------------- map heterogeneous lookup -------------" << RESET << std::endl;
+	{
+		std::vector<std::string> names;
+		for (int i = 0; i < PROBE_KEYS; i++)
+		{
+			std::ostringstream name;
+			name << "sensors/building-a/floor-" << i % 10 << "/probe-" << i;
+			names.push_back(name.str());
+		}
+		ft::map<std::string, int, ft::transparent_less> probes;
+		std::map<std::string, int> std_probes;
+		for (int i = 0; i < PROBE_KEYS; i++)
+		{
+			probes[names[i]] = i;
+			std_probes[names[i]] = i;
+		}
+
+		/* the const char* is compared as is, no temporary std::string */
+		long ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < PROBE_COUNT; i++)
+			ft_sum += probes.find(names[(int)(((long)i * 7919) % PROBE_KEYS)].c_str())->second;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < PROBE_COUNT; i++)
+			std_sum += std_probes.find(names[(int)(((long)i * 7919) % PROBE_KEYS)].c_str())->second;
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum)
+		{
+			std::cout << RED << BOLD << "ft::map - heterogeneous lookup disagrees with std::map" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - heterogeneous lookup is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - heterogeneous lookup is OK" << RESET << std::endl;
+
+	// map node migration
+	std::cout << YELLOW << BOLD << "------------- map node migration -------------" << RESET << std::endl;
+	{
+		typedef counting_allocator<ft::pair<const int, long> >					tier_allocator;
+		typedef ft::map<int, long, std::less<int>, tier_allocator>				tier_map;
+		tier_map hot;
+		tier_map cold;
+		std::map<int, long> std_hot;
+		std::map<int, long> std_cold;
+		for (int i = 0; i < MIGRATE_SIZE; i++)
+		{
+			hot[i] = i;
+			std_hot[i] = i;
+		}
+
+		/* every other entry moves to the cold tier; extract() and insert() relink the node */
+		long allocations = counted_allocations;
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < MIGRATE_SIZE; i += 2)
+			cold.insert(hot.extract(i));
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		allocations = counted_allocations - allocations;
+		/* plain erase and insert: one node freed and one allocated per entry */
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < MIGRATE_SIZE; i += 2)
+		{
+			std::map<int, long>::iterator it = std_hot.find(i);
+			std_cold.insert(*it);
+			std_hot.erase(it);
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		std::cout << WHITE << "allocations during ft migration: " << allocations << RESET << std::endl;
+		if (allocations != 0 || cold.size() != std_cold.size() || hot.size() != std_hot.size())
+		{
+			std::cout << RED << BOLD << "ft::map - node migration allocated or lost nodes" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - node migration is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::map - erase is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::map - node migration is OK" << RESET << std::endl;
 
-	// map relational operators
-	std::cout << YELLOW << BOLD << "------------- map relational operators -------------" << RESET << std::endl;
-	gettimeofday(&ft_start, NULL);
+	// map split / join
+	std::cout << YELLOW << BOLD << "------------- map split / join -------------" << RESET << std::endl;
 	{
-		ft::map<int, int> map_int;
-		ft::map<int, int> map_int2;
-		ft::map<int, int> map_int3;
-		for (int i = 0; i < MAP_SIZE; i++)
+		typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::rb_tree_size_augment>	sized_map;
+		sized_map window;
+		ft::map<int, int> plain_window;
+		std::map<int, int> std_window;
+		for (int i = 0; i < SPLIT_SIZE; i++)
 		{
-			map_int.insert(ft::make_pair(i, i));
-			map_int2.insert(ft::make_pair(i, i));
-			map_int3.insert(ft::make_pair(i + 1, i + 1));
+			window[i] = i;
+			plain_window[i] = i;
+			std_window[i] = i;
 		}
-		if (map_int != map_int2)
+
+		/* both halves are relinked along a few root-to-leaf paths */
+		gettimeofday(&ft_start, NULL);
 		{
-			std::cout << RED << BOLD << "ft::map - relational operators(==) is not OK" << RESET << std::endl;
-			exit(1);
+			sized_map newer = window.split(SPLIT_SIZE / 2);
+			if (window.size() != SPLIT_SIZE / 2 || newer.size() != SPLIT_SIZE / 2
+				|| window.begin()->first != 0 || window.rbegin()->first != SPLIT_SIZE / 2 - 1
+				|| newer.begin()->first != SPLIT_SIZE / 2 || newer.rbegin()->first != SPLIT_SIZE - 1)
+			{
+				std::cout << RED << BOLD << "ft::map - split lost elements" << RESET << std::endl;
+				exit(1);
+			}
+			window.join(newer);
 		}
-		if (map_int > map_int3)
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		/* without subtree sizes the smaller half is also counted */
+		gettimeofday(&obj_start, NULL);
 		{
-			std::cout << RED << BOLD << "ft::map - relational operators(>) is not OK" << RESET << std::endl;
+			ft::map<int, int> newer = plain_window.split(SPLIT_SIZE / 2);
+			if (plain_window.size() != SPLIT_SIZE / 2 || newer.size() != SPLIT_SIZE / 2
+				|| plain_window.rbegin()->first != SPLIT_SIZE / 2 - 1 || newer.begin()->first != SPLIT_SIZE / 2)
+			{
+				std::cout << RED << BOLD << "ft::map - split lost elements" << RESET << std::endl;
+				exit(1);
+			}
+			plain_window.join(newer);
+		}
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		/* copy the upper half out, erase it, copy it back */
+		gettimeofday(&std_start, NULL);
+		{
+			std::map<int, int>::iterator middle = std_window.lower_bound(SPLIT_SIZE / 2);
+			std::map<int, int> newer(middle, std_window.end());
+			std_window.erase(middle, std_window.end());
+			std_window.insert(newer.begin(), newer.end());
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (!same_pairs(window, std_window) || !same_pairs(plain_window, std_window))
+		{
+			std::cout << RED << BOLD << "ft::map - join lost elements" << RESET << std::endl;
 			exit(1);
 		}
 	}
-	gettimeofday(&ft_end, NULL);
-	ft_time = get_time(ft_start, ft_end);
+	std::cout << BLUE << BOLD << "ft sized:\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "ft plain:\t" << obj_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std     :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::map - split / join is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::map - split / join is OK" << RESET << std::endl;
 
-	gettimeofday(&std_start, NULL);
+	// map range erase
+	std::cout << YELLOW << BOLD << "------------- map range erase -------------" << RESET << std::endl;
 	{
-		std::map<int, int> std_map_int;
-		std::map<int, int> std_map_int2;
-		std::map<int, int> std_map_int3;
-		for (int i = 0; i < MAP_SIZE; i++)
-		{
-			std_map_int.insert(std::make_pair(i, i));
-			std_map_int2.insert(std::make_pair(i, i));
-			std_map_int3.insert(std::make_pair(i + 1, i + 1));
-		}
-		if (std_map_int != std_map_int2)
+		ft::map<int, int> ft_window;
+		std::map<int, int> std_window;
+		for (int i = 0; i < EXPIRE_SIZE; i++)
 		{
-			std::cout << RED << BOLD << "std::map - relational operators(==) is not OK" << RESET << std::endl;
-			exit(1);
+			ft_window.insert(ft_window.end(), ft::make_pair(i, i));
+			std_window.insert(std_window.end(), std::make_pair(i, i));
 		}
-		if (std_map_int > std_map_int3)
+
+		/* expire the oldest entries a window at a time, keeping the newest */
+		gettimeofday(&ft_start, NULL);
+		for (int cut = EXPIRE_STEP; cut < EXPIRE_SIZE; cut += EXPIRE_STEP)
+			ft_window.erase(ft_window.begin(), ft_window.lower_bound(cut));
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&std_start, NULL);
+		for (int cut = EXPIRE_STEP; cut < EXPIRE_SIZE; cut += EXPIRE_STEP)
+			std_window.erase(std_window.begin(), std_window.lower_bound(cut));
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_window.size() != std_window.size() || ft_window.begin()->first != std_window.begin()->first)
 		{
-			std::cout << RED << BOLD << "std::map - relational operators(>) is not OK" << RESET << std::endl;
+			std::cout << RED << BOLD << "ft::map - range erase disagrees with std::map" << RESET << std::endl;
 			exit(1);
 		}
 	}
-	gettimeofday(&std_end, NULL);
-	std_time = get_time(std_start, std_end);
 	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
 	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
 	if (std_time && ft_time > 20 * std_time)
 	{
-		std::cout << RED << BOLD << "ft::map - relational operators is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::map - range erase is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::map - relational operators is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::map - range erase is OK" << RESET << std::endl;
 
-	// map swap
-	std::cout << YELLOW << BOLD << "------------- map swap -------------" << RESET << std::endl;
-	gettimeofday(&ft_start, NULL);
+	// map threaded iteration
+	std::cout << YELLOW << BOLD << "------------- map threaded iteration -------------" << RESET << std::endl;
 	{
-		ft::map<int, int> map_int;
-		ft::map<int, int> map_int2;
-		for (int i = 0; i < MAP_SIZE; i++)
+		typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::rb_tree_threaded<> >	threaded_map;
+		threaded_map threaded;
+		ft::map<int, int> plain;
+		std::map<int, int> std_plain;
+		for (int i = 0; i < SCAN_SIZE; i++)
 		{
-			map_int.insert(ft::make_pair(i, i));
-			map_int2.insert(ft::make_pair(i + 1, i + 1));
+			int k = (int)(((long)i * 7919) % SCAN_SIZE);
+			threaded[k] = i;
+			plain[k] = i;
+			std_plain[k] = i;
 		}
-		map_int.swap(map_int2);
-	}
-	gettimeofday(&ft_end, NULL);
-	ft_time = get_time(ft_start, ft_end);
 
-	gettimeofday(&std_start, NULL);
-	{
-		std::map<int, int> std_map_int;
-		std::map<int, int> std_map_int2;
-		for (int i = 0; i < MAP_SIZE; i++)
+		/* ++ follows the in-order link instead of climbing the tree */
+		long ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			for (threaded_map::const_iterator it = threaded.begin(); it != threaded.end(); ++it)
+				ft_sum += it->second;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long obj_sum = 0;
+		gettimeofday(&obj_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			for (ft::map<int, int>::const_iterator it = plain.begin(); it != plain.end(); ++it)
+				obj_sum += it->second;
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			for (std::map<int, int>::const_iterator it = std_plain.begin(); it != std_plain.end(); ++it)
+				std_sum += it->second;
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum || obj_sum != std_sum)
 		{
-			std_map_int.insert(std::make_pair(i, i));
-			std_map_int2.insert(std::make_pair(i + 1, i + 1));
+			std::cout << RED << BOLD << "ft::map - threaded iteration disagrees with std::map" << RESET << std::endl;
+			exit(1);
 		}
-		std_map_int.swap(std_map_int2);
 	}
-	gettimeofday(&std_end, NULL);
-	std_time = get_time(std_start, std_end);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	std::cout << BLUE << BOLD << "ft threaded:\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "ft plain   :\t" << obj_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std        :\t" << std_time << " us" << RESET << std::endl;
 	if (std_time && ft_time > 20 * std_time)
 	{
-		std::cout << RED << BOLD << "ft::map - swap is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::map - threaded iteration is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::map - swap is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::map - threaded iteration is OK" << RESET << std::endl;
 
-	// map clear
-	std::cout << YELLOW << BOLD << "------------- map clear -------------" << RESET << std::endl;
-	gettimeofday(&ft_start, NULL);
+	// map for_each
+	std::cout << YELLOW << BOLD << "------------- map for_each -------------" << RESET << std::endl;
 	{
-		ft::map<int, int> map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			map_int.insert(ft::make_pair(i, i));
-		map_int.clear();
-	}
-	gettimeofday(&ft_end, NULL);
-	ft_time = get_time(ft_start, ft_end);
+		ft::map<int, int> visited;
+		std::map<int, int> std_visited;
+		for (int i = 0; i < SCAN_SIZE; i++)
+		{
+			int k = (int)(((long)i * 7919) % SCAN_SIZE);
+			visited[k] = i;
+			std_visited[k] = i;
+		}
 
-	gettimeofday(&std_start, NULL);
-	{
-		std::map<int, int> std_map_int;
-		for (int i = 0; i < MAP_SIZE; i++)
-			std_map_int.insert(std::make_pair(i, i));
-		std_map_int.clear();
+		/* the visitor keeps its own stack instead of climbing parents */
+		long ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			ft_sum += visited.for_each(sum_second()).sum;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long obj_sum = 0;
+		gettimeofday(&obj_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			for (ft::map<int, int>::const_iterator it = visited.begin(); it != visited.end(); ++it)
+				obj_sum += it->second;
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int pass = 0; pass < SCAN_PASSES; pass++)
+			for (std::map<int, int>::const_iterator it = std_visited.begin(); it != std_visited.end(); ++it)
+				std_sum += it->second;
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		long std_range = 0;
+		for (std::map<int, int>::iterator it = std_visited.lower_bound(SCAN_SIZE / 4); it != std_visited.lower_bound(SCAN_SIZE / 2); ++it)
+			std_range += it->second;
+		if (ft_sum != std_sum || obj_sum != std_sum
+			|| visited.for_each_range(SCAN_SIZE / 4, SCAN_SIZE / 2, sum_second()).sum != std_range)
+		{
+			std::cout << RED << BOLD << "ft::map - for_each disagrees with std::map" << RESET << std::endl;
+			exit(1);
+		}
 	}
-	gettimeofday(&std_end, NULL);
-	std_time = get_time(std_start, std_end);
-	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
-	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	std::cout << BLUE << BOLD << "ft for_each:\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "ft iterator:\t" << obj_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std        :\t" << std_time << " us" << RESET << std::endl;
 	if (std_time && ft_time > 20 * std_time)
 	{
-		std::cout << RED << BOLD << "ft::map - clear is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		std::cout << RED << BOLD << "ft::map - for_each is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
 		exit(1);
 	}
 	else
-		std::cout << GREEN << BOLD << "ft::map - clear is OK" << RESET << std::endl;
+		std::cout << GREEN << BOLD << "ft::map - for_each is OK" << RESET << std::endl;
 
+	// map batched lookup
+	std::cout << YELLOW << BOLD << "------------- map batched lookup -------------" << RESET << std::endl;
+	for (int size = 10000; size <= 1000000; size *= 10)
+	{
+		typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::rb_tree_prefetching<> >	prefetching_map;
+		ft::map<int, int> plain;
+		prefetching_map prefetching;
+		std::map<int, int> std_plain;
+		for (int i = 0; i < size; i++)
+		{
+			int k = (int)(((long)i * 7919) % size);
+			plain[k] = i;
+			prefetching[k] = i;
+			std_plain[k] = i;
+		}
+		std::vector<int> keys(BATCH_QUERIES);
+		for (int i = 0; i < BATCH_QUERIES; i++)
+			keys[i] = (int)(((long)i * 104729) % size);
+
+		/* find_many interleaves sixteen descents, each prefetching its next node */
+		long ft_sum = 0;
+		std::vector<ft::map<int, int>::iterator> found(BATCH_QUERIES);
+		gettimeofday(&ft_start, NULL);
+		plain.find_many(keys.begin(), keys.end(), found.begin());
+		for (int i = 0; i < BATCH_QUERIES; i++)
+			ft_sum += found[i]->second;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long obj_sum = 0;
+		gettimeofday(&obj_start, NULL);
+		for (int i = 0; i < BATCH_QUERIES; i++)
+			obj_sum += plain.find(keys[i])->second;
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		long pre_sum = 0;
+		timeval pre_start, pre_end;
+		gettimeofday(&pre_start, NULL);
+		for (int i = 0; i < BATCH_QUERIES; i++)
+			pre_sum += prefetching.find(keys[i])->second;
+		gettimeofday(&pre_end, NULL);
+		size_t pre_time = get_time(pre_start, pre_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < BATCH_QUERIES; i++)
+			std_sum += std_plain.find(keys[i])->second;
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum || obj_sum != std_sum || pre_sum != std_sum)
+		{
+			std::cout << RED << BOLD << "ft::map - batched lookup disagrees with std::map" << RESET << std::endl;
+			exit(1);
+		}
+		/* lookups per second, in thousands */
+		std::cout << WHITE << BOLD << size << " keys:" << RESET << std::endl;
+		std::cout << BLUE << BOLD << "ft find_many  :\t" << BATCH_QUERIES * 1000L / (ft_time ? ft_time : 1) << " k/s" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "ft prefetching:\t" << BATCH_QUERIES * 1000L / (pre_time ? pre_time : 1) << " k/s" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "ft find       :\t" << BATCH_QUERIES * 1000L / (obj_time ? obj_time : 1) << " k/s" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "std find      :\t" << BATCH_QUERIES * 1000L / (std_time ? std_time : 1) << " k/s" << RESET << std::endl;
+		if (std_time && ft_time > 20 * std_time)
+		{
+			std::cout << RED << BOLD << "ft::map - batched lookup is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << GREEN << BOLD << "ft::map - batched lookup is OK" << RESET << std::endl;
 
 	// SET TEST
 
@@ -913,6 +2373,253 @@ int main(void)
 	else
 		std::cout << GREEN << BOLD << "ft::set - insert is OK" << RESET << std::endl;
 
+	// set node layout
+	std::cout << YELLOW << BOLD << "------------- set node layout -------------" << RESET << std::endl;
+	std::cout << WHITE << "set<int>      node: " << sizeof(ft::rb_tree_node<int>) << " bytes (was " << sizeof(legacy_rb_tree_node<int>) << ")" << RESET << std::endl;
+	std::cout << WHITE << "map<int, int> node: " << sizeof(ft::rb_tree_node<ft::pair<const int, int> >) << " bytes (was " << sizeof(legacy_rb_tree_node<ft::pair<const int, int> >) << ")" << RESET << std::endl;
+	{
+		ft::set<int> lookup_set;
+		std::set<int> std_lookup_set;
+		for (int i = 0; i < LOOKUP_SIZE; i++)
+		{
+			lookup_set.insert((int)(((long)i * 7919) % LOOKUP_SIZE));
+			std_lookup_set.insert((int)(((long)i * 7919) % LOOKUP_SIZE));
+		}
+		size_t	hits = 0;
+
+		/* keys are scattered, so nearly every step of a descent misses the cache */
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < LOOKUP_SIZE / 5; i++)
+			hits += lookup_set.find((int)(((long)i * 104729) % (2 * LOOKUP_SIZE))) != lookup_set.end();
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < LOOKUP_SIZE / 5; i++)
+			hits += std_lookup_set.find((int)(((long)i * 104729) % (2 * LOOKUP_SIZE))) != std_lookup_set.end();
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		std::cout << WHITE << "hits: " << hits << RESET << std::endl;
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::set - scattered find is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::set - scattered find is OK" << RESET << std::endl;
+
+	// set bulk load
+	std::cout << YELLOW << BOLD << "------------- set bulk load -------------" << RESET << std::endl;
+	{
+		std::vector<int> sorted_keys;
+		for (int i = 0; i < BULK_SIZE; i++)
+			sorted_keys.push_back(i * 2);
+
+		/* an empty set takes sorted input in one linear pass */
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::set<int> bulk(sorted_keys.begin(), sorted_keys.end());
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		/* one descent and rebalance per key */
+		gettimeofday(&obj_start, NULL);
+		{
+			ft::set<int> one_by_one;
+			for (std::vector<int>::iterator it = sorted_keys.begin(); it != sorted_keys.end(); ++it)
+				one_by_one.insert(*it);
+		}
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		gettimeofday(&std_start, NULL);
+		{
+			std::set<int> std_bulk(sorted_keys.begin(), sorted_keys.end());
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+	}
+	std::cout << BLUE << BOLD << "ft bulk:\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "ft each:\t" << obj_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std    :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::set - bulk load is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::set - bulk load is OK" << RESET << std::endl;
+
+	// set order statistics
+	std::cout << YELLOW << BOLD << "------------- set order statistics -------------" << RESET << std::endl;
+	{
+		ft::set<int, std::less<int>, std::allocator<int>, ft::rb_tree_size_augment> ranked;
+		std::set<int> std_ranked;
+		for (int i = 0; i < RANK_SIZE; i++)
+		{
+			ranked.insert((int)(((long)i * 7919) % RANK_SIZE));
+			std_ranked.insert((int)(((long)i * 7919) % RANK_SIZE));
+		}
+
+		/* nth() and rank() descend by subtree size */
+		long ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < RANK_QUERIES; i++)
+		{
+			int k = (int)(((long)i * 7919) % RANK_SIZE);
+			ft_sum += *ranked.nth(k);
+			ft_sum += ranked.rank(k);
+			ft_sum += ranked.distance(ranked.begin(), ranked.find(k));
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		long std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		for (int i = 0; i < RANK_QUERIES; i++)
+		{
+			int k = (int)(((long)i * 7919) % RANK_SIZE);
+			std::set<int>::iterator it = std_ranked.begin();
+			std::advance(it, k);
+			std_sum += *it;
+			std_sum += std::distance(std_ranked.begin(), std_ranked.lower_bound(k));
+			std_sum += std::distance(std_ranked.begin(), std_ranked.find(k));
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum)
+		{
+			std::cout << RED << BOLD << "ft::set - order statistics disagree with std::set" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::set - order statistics is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::set - order statistics is OK" << RESET << std::endl;
+
+	// set algebra
+	std::cout << YELLOW << BOLD << "------------- set algebra -------------" << RESET << std::endl;
+	{
+		ft::set<int> ft_even, ft_third, ft_few;
+		std::set<int> std_even, std_third, std_few;
+		for (int i = 0; i < ALGEBRA_SIZE; i++)
+		{
+			ft_even.insert(ft_even.end(), 2 * i);
+			ft_third.insert(ft_third.end(), 3 * i);
+			std_even.insert(std_even.end(), 2 * i);
+			std_third.insert(std_third.end(), 3 * i);
+		}
+		for (int i = 0; i < ALGEBRA_SMALL; i++)
+		{
+			ft_few.insert((int)(((long)i * 7919) % ALGEBRA_SIZE));
+			std_few.insert((int)(((long)i * 7919) % ALGEBRA_SIZE));
+		}
+
+		/* similar sizes merge and bulk build, a small side splits and joins */
+		size_t ft_sum = 0;
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::set<int> u = ft::set_union(ft_even, ft_third);
+			ft::set<int> x = ft::set_intersection(ft_even, ft_third);
+			ft::set<int> s = ft::set_symmetric_difference(ft_even, ft_third);
+			ft::set<int> few = ft::set_intersection(ft_few, ft_even);
+			ft_even.difference_with(ft_few);
+			ft_sum = u.size() + x.size() + s.size() + few.size() + ft_even.size();
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		size_t std_sum = 0;
+		gettimeofday(&std_start, NULL);
+		{
+			std::set<int> u, x, s, few;
+			std::set_union(std_even.begin(), std_even.end(), std_third.begin(), std_third.end(), std::inserter(u, u.end()));
+			std::set_intersection(std_even.begin(), std_even.end(), std_third.begin(), std_third.end(), std::inserter(x, x.end()));
+			std::set_symmetric_difference(std_even.begin(), std_even.end(), std_third.begin(), std_third.end(), std::inserter(s, s.end()));
+			std::set_intersection(std_few.begin(), std_few.end(), std_even.begin(), std_even.end(), std::inserter(few, few.end()));
+			for (std::set<int>::iterator it = std_few.begin(); it != std_few.end(); ++it)
+				std_even.erase(*it);
+			std_sum = u.size() + x.size() + s.size() + few.size() + std_even.size();
+		}
+		gettimeofday(&std_end, NULL);
+		std_time = get_time(std_start, std_end);
+		if (ft_sum != std_sum || !std::equal(ft_even.begin(), ft_even.end(), std_even.begin()))
+		{
+			std::cout << RED << BOLD << "ft::set - set algebra disagrees with std::set" << RESET << std::endl;
+			exit(1);
+		}
+	}
+	std::cout << BLUE << BOLD << "ft  :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "std :\t" << std_time << " us" << RESET << std::endl;
+	if (std_time && ft_time > 20 * std_time)
+	{
+		std::cout << RED << BOLD << "ft::set - set algebra is " << (double)ft_time / std_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::set - set algebra is OK" << RESET << std::endl;
+	{
+		/* a copy throwing partway leaves the set as it was, merged or split and joined */
+		ft::set<FragileInt> kept, added, few;
+		for (int i = 0; i < 1000; i++)
+		{
+			kept.insert(FragileInt(2 * i));
+			added.insert(FragileInt(2 * i + 1));
+		}
+		for (int i = 0; i < 10; i++)
+			few.insert(FragileInt(100 * i + 1));
+		int thrown = 0;
+		copies_left = 500;
+		try { kept.union_with(added); } catch (std::bad_alloc&) { ++thrown; }
+		copies_left = 5;
+		try { kept.symmetric_difference_with(few); } catch (std::bad_alloc&) { ++thrown; }
+		copies_left = -1;
+		int expect = 0;
+		ft::set<FragileInt>::iterator it = kept.begin();
+		for (; it != kept.end() && it->value == expect; ++it)
+			expect += 2;
+		if (thrown != 2 || it != kept.end() || kept.size() != 1000)
+		{
+			std::cout << RED << BOLD << "ft::set - set algebra lost elements on a throwing copy" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::set - set algebra on a throwing copy is OK" << RESET << std::endl;
+	}
+	{
+		/* on equivalent keys the left side's element stays, merged or split and joined */
+		ft::set<TaggedInt> ours, theirs, few;
+		for (int i = 0; i < 1000; i++)
+		{
+			ours.insert(TaggedInt(i, 1));
+			theirs.insert(TaggedInt(2 * i, 2));
+		}
+		for (int i = 0; i < 10; i++)
+			few.insert(TaggedInt(100 * i, 3));
+		ft::set<TaggedInt> merged(ours), joined(ours), small(few);
+		merged.union_with(theirs);
+		joined.union_with(few);
+		small.union_with(ours);
+		ft::set<TaggedInt> left = ft::set_union(few, ours);
+		ft::set<TaggedInt> right = ft::set_union(ours, few);
+		ft::set<TaggedInt> both = ft::set_intersection(few, ours);
+		if (tag_of(merged, 500) != 1 || tag_of(merged, 1500) != 2 || merged.size() != 1500
+			|| tag_of(joined, 500) != 1 || joined.size() != 1000
+			|| tag_of(small, 500) != 3 || tag_of(small, 501) != 1 || small.size() != 1000
+			|| tag_of(left, 500) != 3 || tag_of(right, 500) != 1 || tag_of(both, 500) != 3)
+		{
+			std::cout << RED << BOLD << "ft::set - set algebra kept the wrong element" << RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::set - set algebra keeps the left element" << RESET << std::endl;
+	}
+
 	// map find
 	std::cout << YELLOW << BOLD << "------------- set find -------------" << RESET << std::endl;
 	gettimeofday(&ft_start, NULL);
@@ -1110,6 +2817,163 @@ int main(void)
 	else
 		std::cout << GREEN << BOLD << "ft::set - clear is OK" << RESET << std::endl;
 
+	// BTREE TEST
+
+	std::cout << CYAN << BOLD << "\n\n------------- btree -------------\n\n" << RESET << std::endl;
+
+	// btree_map insert
+	std::cout << YELLOW << BOLD << "------------- btree_map insert -------------" << RESET << std::endl;
+	{
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::btree_map<int, int> btree_map_int;
+			for (int i = 0; i < BTREE_SIZE; i++)
+				btree_map_int.insert(ft::make_pair((int)(((long)i * 7919) % BTREE_SIZE), i));
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&obj_start, NULL);
+		{
+			ft::map<int, int> map_int;
+			for (int i = 0; i < BTREE_SIZE; i++)
+				map_int.insert(ft::make_pair((int)(((long)i * 7919) % BTREE_SIZE), i));
+		}
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+	}
+	std::cout << BLUE << BOLD << "btree :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "rbtree:\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::btree_map - insert is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::btree_map - insert is OK" << RESET << std::endl;
+
+	// btree_map find / iteration
+	std::cout << YELLOW << BOLD << "------------- btree_map find / iteration -------------" << RESET << std::endl;
+	{
+		ft::btree_map<int, int> btree_map_int;
+		ft::map<int, int> map_int;
+		for (int i = 0; i < BTREE_SIZE; i++)
+		{
+			btree_map_int.insert(ft::make_pair((int)(((long)i * 7919) % BTREE_SIZE), i));
+			map_int.insert(ft::make_pair((int)(((long)i * 7919) % BTREE_SIZE), i));
+		}
+		long	sum = 0;
+
+		gettimeofday(&ft_start, NULL);
+		for (int i = 0; i < BTREE_SIZE; i++)
+			sum += btree_map_int.find((int)(((long)i * 104729) % BTREE_SIZE))->second;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&obj_start, NULL);
+		for (int i = 0; i < BTREE_SIZE; i++)
+			sum += map_int.find((int)(((long)i * 104729) % BTREE_SIZE))->second;
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		std::cout << BLUE << BOLD << "btree  find:\t" << ft_time << " us" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "rbtree find:\t" << obj_time << " us" << RESET << std::endl;
+		if (obj_time && ft_time > 20 * obj_time)
+		{
+			std::cout << RED << BOLD << "ft::btree_map - find is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+			exit(1);
+		}
+
+		gettimeofday(&ft_start, NULL);
+		for (ft::btree_map<int, int>::iterator it = btree_map_int.begin(); it != btree_map_int.end(); ++it)
+			sum += it->second;
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&obj_start, NULL);
+		for (ft::map<int, int>::iterator it = map_int.begin(); it != map_int.end(); ++it)
+			sum += it->second;
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		std::cout << BLUE << BOLD << "btree  walk:\t" << ft_time << " us" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "rbtree walk:\t" << obj_time << " us" << RESET << std::endl;
+		std::cout << WHITE << "sum: " << sum << RESET << std::endl;
+	}
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::btree_map - iteration is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::btree_map - find / iteration is OK" << RESET << std::endl;
+
+	// btree_set insert / erase
+	std::cout << YELLOW << BOLD << "------------- btree_set insert / erase -------------" << RESET << std::endl;
+	{
+		gettimeofday(&ft_start, NULL);
+		{
+			ft::btree_set<int> btree_set_int;
+			for (int i = 0; i < BTREE_SIZE; i++)
+				btree_set_int.insert((int)(((long)i * 7919) % BTREE_SIZE));
+			for (int i = 0; i < BTREE_SIZE; i += 2)
+				btree_set_int.erase(i);
+		}
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&obj_start, NULL);
+		{
+			ft::set<int> set_int;
+			for (int i = 0; i < BTREE_SIZE; i++)
+				set_int.insert((int)(((long)i * 7919) % BTREE_SIZE));
+			for (int i = 0; i < BTREE_SIZE; i += 2)
+				set_int.erase(i);
+		}
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+	}
+	std::cout << BLUE << BOLD << "btree :\t" << ft_time << " us" << RESET << std::endl;
+	std::cout << MAGENTA << BOLD << "rbtree:\t" << obj_time << " us" << RESET << std::endl;
+	if (obj_time && ft_time > 20 * obj_time)
+	{
+		std::cout << RED << BOLD << "ft::btree_set - insert / erase is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+		exit(1);
+	}
+	else
+		std::cout << GREEN << BOLD << "ft::btree_set - insert / erase is OK" << RESET << std::endl;
+
+	// btree_set range erase
+	std::cout << YELLOW << BOLD << "------------- btree_set range erase -------------" << RESET << std::endl;
+	{
+		/* a run of slots in one leaf goes at once, with one descent per leaf */
+		ft::btree_set<int> btree_set_int;
+		ft::set<int> set_int;
+		for (int i = 0; i < BTREE_SIZE; i++)
+		{
+			btree_set_int.insert((int)(((long)i * 7919) % BTREE_SIZE));
+			set_int.insert((int)(((long)i * 7919) % BTREE_SIZE));
+		}
+		gettimeofday(&ft_start, NULL);
+		btree_set_int.erase(btree_set_int.lower_bound(100), btree_set_int.lower_bound(BTREE_SIZE - 100));
+		gettimeofday(&ft_end, NULL);
+		ft_time = get_time(ft_start, ft_end);
+		gettimeofday(&obj_start, NULL);
+		set_int.erase(set_int.lower_bound(100), set_int.lower_bound(BTREE_SIZE - 100));
+		gettimeofday(&obj_end, NULL);
+		obj_time = get_time(obj_start, obj_end);
+		std::cout << BLUE << BOLD << "btree :\t" << ft_time << " us" << RESET << std::endl;
+		std::cout << MAGENTA << BOLD << "rbtree:\t" << obj_time << " us" << RESET << std::endl;
+		ft::btree_set<int>::iterator it = btree_set_int.find(99);
+		if (btree_set_int.size() != 200 || it == btree_set_int.end() || *++it != BTREE_SIZE - 100
+			|| !ft::equal(set_int.begin(), set_int.end(), btree_set_int.begin()))
+		{
+			std::cout << RED << BOLD << "ft::btree_set - range erase is wrong" << RESET << std::endl;
+			exit(1);
+		}
+		if (obj_time && ft_time > 20 * obj_time)
+		{
+			std::cout << RED << BOLD << "ft::btree_set - range erase is " << (double)ft_time / obj_time << " times slow" <<  RESET << std::endl;
+			exit(1);
+		}
+		else
+			std::cout << GREEN << BOLD << "ft::btree_set - range erase is OK" << RESET << std::endl;
+	}
+
 	std::cout << CYAN << BOLD << "\n\n------------- LEAKS -------------\n\n" << RESET << std::endl;
 
 	system("leaks ft_containers");
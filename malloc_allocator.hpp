@@ -0,0 +1,102 @@
+#ifndef MALLOC_ALLOCATOR_HPP
+#define MALLOC_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include "type_traits.hpp"
+
+namespace ft
+{
+	// std::allocator work-alike on top of malloc, so that containers can
+	// grow trivially relocatable storage in place with realloc();
+	template <class T>
+	class malloc_allocator
+	{
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind {
+			typedef malloc_allocator<U>	other;
+		};
+
+		malloc_allocator() {}
+		malloc_allocator(const malloc_allocator&) {}
+		template <class U>
+		malloc_allocator(const malloc_allocator<U>&) {}
+		~malloc_allocator() {}
+
+		pointer			address(reference x) const {
+			return &x;
+		}
+
+		const_pointer	address(const_reference x) const {
+			return &x;
+		}
+
+		pointer			allocate(size_type n, const void* = 0) {
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+			void*	p = std::malloc(n * sizeof(T));
+			if (p == 0 && n != 0) {
+				throw std::bad_alloc();
+			}
+			return static_cast<pointer>(p);
+		}
+
+		// contents up to min(old_n, n) are kept; the block may move;
+		pointer			reallocate(pointer p, size_type, size_type n) {
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+			void*	q = std::realloc(static_cast<void*>(p), n * sizeof(T));
+			if (q == 0 && n != 0) {
+				throw std::bad_alloc();
+			}
+			return static_cast<pointer>(q);
+		}
+
+		void			deallocate(pointer p, size_type) {
+			std::free(static_cast<void*>(p));
+		}
+
+		size_type		max_size() const {
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		void			construct(pointer p, const T& val) {
+			new(static_cast<void*>(p)) T(val);
+		}
+
+		void			destroy(pointer p) {
+			p->~T();
+		}
+	};
+
+	template <class T, class U>
+	bool	operator==(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+		return true;
+	}
+
+	template <class T, class U>
+	bool	operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+		return false;
+	}
+
+	template <class Alloc>
+	struct is_reallocatable : public false_type {};
+
+	template <class T>
+	struct is_reallocatable<malloc_allocator<T> > : public true_type {};
+}
+
+#endif
@@ -21,9 +21,29 @@ struct SelectFirst
 	}
 };
 
+// monoid for rb_tree_monoid_augment: the sum of the mapped values
+template<class Pair>
+struct SumSecond
+{
+	typedef typename Pair::second_type	result_type;
+
+	result_type	identity() const {
+		return result_type();
+	}
+
+	result_type	lift(const Pair& x) const {
+		return x.second;
+	}
+
+	result_type	combine(const result_type& x, const result_type& y) const {
+		return x + y;
+	}
+};
+
 
 template <class Key, class T, class Compare = std::less<Key>, \
-typename Alloc = std::allocator<ft::pair<const Key, T> > >
+typename Alloc = std::allocator<ft::pair<const Key, T> >, \
+class Augment = rb_tree_no_augment>
 class map
 {
 public:
@@ -35,23 +55,41 @@ public:
 
 private:
 	typedef ft::rbtree<key_type, value_type, \
-	SelectFirst<value_type>, key_compare, Alloc>	rbtree_type;
+	SelectFirst<value_type>, key_compare, Alloc, Augment>	rbtree_type;
+	typedef typename rbtree_type::iterator					rbtree_iterator;
 	rbtree_type	tree;
+
+	// when Augment folds the mapped values, a write the tree does not see
+	// would leave the totals stale: such a map hands out const access only
+	// and the values change through update();
+	template <class Mutable, class Constant>
+	struct access : public ft::conditional<Augment::reads_values, Constant, Mutable> {};
+
+	typename access<rbtree_type, const rbtree_type>::type&	values() {
+		return tree;
+	}
 public:
-	typedef typename rbtree_type::pointer					pointer;
+	typedef typename access<typename rbtree_type::pointer, \
+	typename rbtree_type::const_pointer>::type				pointer;
 	typedef typename rbtree_type::const_pointer				const_pointer;
-	typedef typename rbtree_type::reference					reference;
+	typedef typename access<typename rbtree_type::reference, \
+	typename rbtree_type::const_reference>::type			reference;
 	typedef typename rbtree_type::const_reference			const_reference;
-	typedef typename rbtree_type::iterator					iterator;
+	typedef typename access<typename rbtree_type::iterator, \
+	typename rbtree_type::const_iterator>::type				iterator;
 	typedef typename rbtree_type::const_iterator			const_iterator;
-	typedef typename rbtree_type::reverse_iterator			reverse_iterator;
+	typedef typename access<typename rbtree_type::reverse_iterator, \
+	typename rbtree_type::const_reverse_iterator>::type		reverse_iterator;
 	typedef typename rbtree_type::const_reverse_iterator	const_reverse_iterator;
 	typedef typename rbtree_type::size_type					size_type;
 	typedef typename rbtree_type::difference_type			difference_type;
 	typedef typename rbtree_type::allocator_type			allocator_type;
+	typedef typename rbtree_type::node_handle				node_type;
+	typedef typename rbtree_type::template node_insert_return<iterator>	insert_return_type;
+	typedef typename access<T&, const T&>::type				mapped_reference;
 
 	class value_compare {
-		friend class map<Key, T, Compare, Alloc>;
+		friend class map<Key, T, Compare, Alloc, Augment>;
 		protected:
 			Compare	comp;
 			value_compare(Compare c)
@@ -80,11 +118,21 @@ public:
 	map(const map& x)
 	: tree(x.tree) {}
 
-	map<Key, T, Compare, Alloc>&	operator=(const map<Key, T, Compare, Alloc>& x) {
+	map<Key, T, Compare, Alloc, Augment>&	operator=(const map<Key, T, Compare, Alloc, Augment>& x) {
 		tree = x.tree;
 		return *this;
 	}
 
+#if __cplusplus >= 201103L
+	map(map&& x)
+	: tree(std::move(x.tree)) {}
+
+	map<Key, T, Compare, Alloc, Augment>&	operator=(map<Key, T, Compare, Alloc, Augment>&& x) {
+		tree = std::move(x.tree);
+		return *this;
+	}
+#endif
+
 	~map() {
 		clear();
 	}
@@ -147,34 +195,79 @@ public:
 		return tree.max_size();
 	}
 
-	T&	operator[](const key_type& k) {
-		iterator	i = lower_bound(k);
-		if (i == end() || key_comp()(k, (*i).first)) {
-			i = insert(i, value_type(k, T()));
+	mapped_reference	operator[](const key_type& k) {
+		rbtree_iterator	i = tree.lower_bound(k);
+		if (i == tree.end() || key_comp()(k, (*i).first)) {
+#if __cplusplus >= 201103L
+			i = tree.emplace_hint(i, k, T());
+#else
+			i = tree.insert(i, value_type(k, T()));
+#endif
 		}
 		return (*i).second;
 	}
 
-	void	swap(map<Key, T, Compare, Alloc>& x) {
+#if __cplusplus >= 201103L
+	mapped_reference	operator[](key_type&& k) {
+		rbtree_iterator	i = tree.lower_bound(k);
+		if (i == tree.end() || key_comp()(k, (*i).first)) {
+			i = tree.emplace_hint(i, std::move(k), T());
+		}
+		return (*i).second;
+	}
+#endif
+
+	// writes the mapped value at position and refolds the aggregates above
+	// it; the only way to change a value when Augment::reads_values;
+	void	update(iterator position, const T& x) {
+		rbtree_iterator	i = (rbtree_iterator&)position;
+		(*i).second = x;
+		tree.refresh(i);
+	}
+
+	void	swap(map<Key, T, Compare, Alloc, Augment>& x) {
 		tree.swap(x.tree);
 	}
 
 	// insert / erase
 	ft::pair<iterator, bool>	insert(const value_type& x) {
-		return tree.insert(x);
+		ft::pair<rbtree_iterator, bool>	p = tree.insert(x);
+		return ft::pair<iterator, bool>(p.first, p.second);
 	}
 
 	iterator	insert(iterator position, const value_type& x) {
-		return tree.insert(position, x);
+		return tree.insert((rbtree_iterator&)position, x);
 	}
 
+#if __cplusplus >= 201103L
+	ft::pair<iterator, bool>	insert(value_type&& x) {
+		ft::pair<rbtree_iterator, bool>	p = tree.insert(std::move(x));
+		return ft::pair<iterator, bool>(p.first, p.second);
+	}
+
+	iterator	insert(iterator position, value_type&& x) {
+		return tree.insert((rbtree_iterator&)position, std::move(x));
+	}
+
+	template <class... Args>
+	ft::pair<iterator, bool>	emplace(Args&&... args) {
+		ft::pair<rbtree_iterator, bool>	p = tree.emplace(std::forward<Args>(args)...);
+		return ft::pair<iterator, bool>(p.first, p.second);
+	}
+
+	template <class... Args>
+	iterator	emplace_hint(iterator position, Args&&... args) {
+		return tree.emplace_hint((rbtree_iterator&)position, std::forward<Args>(args)...);
+	}
+#endif
+
 	template<class InputIterator>
 	void	insert(InputIterator first, InputIterator last) {
 		tree.insert(first, last);
 	}
 
 	void	erase(iterator position) {
-		tree.erase(position);
+		tree.erase((rbtree_iterator&)position);
 	}
 
 	size_type	erase(const key_type& x) {
@@ -182,13 +275,65 @@ public:
 	}
 
 	void	erase(iterator first, iterator last) {
-		tree.erase(first, last);
+		tree.erase((rbtree_iterator&)first, (rbtree_iterator&)last);
 	}
 
 	void	clear() {
 		tree.clear();
 	}
 
+	// node handles; the nodes are relinked, not reallocated
+	node_type	extract(iterator position) {
+		return tree.extract((rbtree_iterator&)position);
+	}
+
+	node_type	extract(const key_type& x) {
+		return tree.extract(x);
+	}
+
+#if __cplusplus >= 201103L
+	insert_return_type	insert(node_type&& nh) {
+		typename rbtree_type::insert_return_type	r = tree.insert(std::move(nh));
+		return insert_return_type(r.position, r.inserted, std::move(r.node));
+	}
+
+	iterator	insert(iterator position, node_type&& nh) {
+		return tree.insert((rbtree_iterator&)position, std::move(nh));
+	}
+
+	void	merge(map<Key, T, Compare, Alloc, Augment>&& source) {
+		tree.merge(source.tree);
+	}
+#else
+	insert_return_type	insert(const node_type& nh) {
+		typename rbtree_type::insert_return_type	r = tree.insert(nh);
+		return insert_return_type(r.position, r.inserted, r.node);
+	}
+
+	iterator	insert(iterator position, const node_type& nh) {
+		return tree.insert((rbtree_iterator&)position, nh);
+	}
+#endif
+
+	void	merge(map<Key, T, Compare, Alloc, Augment>& source) {
+		tree.merge(source.tree);
+	}
+
+	// split and join relink the nodes: split() leaves the keys below k
+	// here and returns the rest, join() appends a map whose keys are all
+	// greater and empties it. join() is O(log n), and so is split() when
+	// Augment keeps subtree sizes; a map without them pays a linear count
+	// of the smaller side to split
+	map<Key, T, Compare, Alloc, Augment>	split(const key_type& k) {
+		map<Key, T, Compare, Alloc, Augment>	upper(key_comp(), get_allocator());
+		tree.split(k, upper.tree);
+		return upper;
+	}
+
+	void	join(map<Key, T, Compare, Alloc, Augment>& other) {
+		tree.join(other.tree);
+	}
+
 	iterator	find(const key_type& x) {
 		return tree.find(x);
 	}
@@ -222,57 +367,173 @@ public:
 	}
 
 	ft::pair<iterator, iterator>	equal_range(const key_type& x) {
-		return tree.equal_range(x);
+		ft::pair<rbtree_iterator, rbtree_iterator>	p = tree.equal_range(x);
+		return ft::pair<iterator, iterator>(p.first, p.second);
 	}
 
 	ft::pair<const_iterator, const_iterator>	equal_range(const key_type& x) const {
 		return tree.equal_range(x);
 	}
 
-	template<class K1, class T1, class C1, class A1>
-	friend bool	operator==(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
-	template<class K1, class T1, class C1, class A1>
-	friend bool	operator<(const map<K1, T1, C1, A1>&, const map<K1, T1, C1, A1>&);
+	// heterogeneous lookup, enabled when Compare has is_transparent
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	find(const K& x) {
+		return tree.find(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+	find(const K& x) const {
+		return tree.find(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, size_type>::type
+	count(const K& x) const {
+		return tree.count(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	lower_bound(const K& x) {
+		return tree.lower_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+	lower_bound(const K& x) const {
+		return tree.lower_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	upper_bound(const K& x) {
+		return tree.upper_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+	upper_bound(const K& x) const {
+		return tree.upper_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, ft::pair<iterator, iterator> >::type
+	equal_range(const K& x) {
+		ft::pair<rbtree_iterator, rbtree_iterator>	p = tree.equal_range(x);
+		return ft::pair<iterator, iterator>(p.first, p.second);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, ft::pair<const_iterator, const_iterator> >::type
+	equal_range(const K& x) const {
+		return tree.equal_range(x);
+	}
+
+	// order statistics, O(log n) with Augment = rb_tree_size_augment
+	iterator	nth(size_type k) {
+		return tree.nth(k);
+	}
+
+	const_iterator	nth(size_type k) const {
+		return tree.nth(k);
+	}
+
+	size_type	rank(const key_type& x) const {
+		return tree.rank(x);
+	}
+
+	difference_type	distance(const_iterator first, const_iterator last) const {
+		return tree.distance(first, last);
+	}
+
+	// Augment's monoid over the keys in [lo, hi), O(log n) when the tree
+	// keeps it (rb_tree_monoid_augment, whose values only change through
+	// update()); a plain map counts the range
+	typename Augment::result_type	aggregate(const key_type& lo, const key_type& hi) const {
+		return tree.aggregate(lo, hi);
+	}
+
+	// an iterator per key of [first, last) to out, end() when absent; the
+	// lookups are interleaved to overlap their cache misses
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator	find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+		return values().find_many(first, last, out);
+	}
+
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator	find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+		return tree.find_many(first, last, out);
+	}
+
+	// f on every element in order, or on the keys in [lo, hi); faster
+	// than an iterator loop when only the elements are wanted. f gets
+	// const elements when Augment::reads_values
+	template <class Function>
+	Function	for_each(Function f) {
+		return values().for_each(f);
+	}
+
+	template <class Function>
+	Function	for_each(Function f) const {
+		return tree.for_each(f);
+	}
+
+	template <class Function>
+	Function	for_each_range(const key_type& lo, const key_type& hi, Function f) {
+		return values().for_each_range(lo, hi, f);
+	}
+
+	template <class Function>
+	Function	for_each_range(const key_type& lo, const key_type& hi, Function f) const {
+		return tree.for_each_range(lo, hi, f);
+	}
+
+	template<class K1, class T1, class C1, class A1, class U1>
+	friend bool	operator==(const map<K1, T1, C1, A1, U1>&, const map<K1, T1, C1, A1, U1>&);
+	template<class K1, class T1, class C1, class A1, class U1>
+	friend bool	operator<(const map<K1, T1, C1, A1, U1>&, const map<K1, T1, C1, A1, U1>&);
 };
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator==(const map<Key, T, Compare, Alloc>& x,
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator==(const map<Key, T, Compare, Alloc, Augment>& x,
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return x.tree == y.tree;
 }
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator<(const map<Key, T, Compare, Alloc>& x, \
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator<(const map<Key, T, Compare, Alloc, Augment>& x, \
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return x.tree < y.tree;
 }
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator!=(const map<Key, T, Compare, Alloc>& x, \
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator!=(const map<Key, T, Compare, Alloc, Augment>& x, \
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return !(x == y);
 }
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator>(const map<Key, T, Compare, Alloc>& x, \
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator>(const map<Key, T, Compare, Alloc, Augment>& x, \
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return y < x;
 }
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator<=(const map<Key, T, Compare, Alloc>&x, \
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator<=(const map<Key, T, Compare, Alloc, Augment>&x, \
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return !(y < x);
 }
 
-template<class Key, class T, class Compare, class Alloc>
-bool	operator>=(const map<Key, T, Compare, Alloc>& x, \
-const map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+bool	operator>=(const map<Key, T, Compare, Alloc, Augment>& x, \
+const map<Key, T, Compare, Alloc, Augment>& y) {
 	return !(x < y);
 }
 
-template<class Key, class T, class Compare, class Alloc>
-void	swap(map<Key, T, Compare, Alloc>& x, map<Key, T, Compare, Alloc>& y) {
+template<class Key, class T, class Compare, class Alloc, class Augment>
+void	swap(map<Key, T, Compare, Alloc, Augment>& x, map<Key, T, Compare, Alloc, Augment>& y) {
 	x.swap(y);
 }
 
@@ -0,0 +1,237 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <limits>
+
+namespace ft
+{
+	// the slots of one size: those freed, and those not yet handed out
+	// from the newest block carved for this size;
+	struct pool_allocator_class
+	{
+		pool_allocator_class*	next;
+		std::size_t				slot;
+		void*					free_list;
+		char*					cursor;
+		char*					limit;
+	};
+
+	// what every copy and rebound copy of one pool_allocator shares;
+	struct pool_allocator_state
+	{
+		std::size_t				refs;
+		pool_allocator_class*	classes;
+		void*					blocks;
+		std::size_t				reserved;
+	};
+
+	// single-object allocator for node based containers: nodes are carved
+	// out of blocks of BlockNodes slots, freed nodes go on a free list and
+	// the blocks themselves are only returned when the last copy of the
+	// allocator goes away. Copies and rebound copies share one pool, which
+	// keeps a free list per slot size, so the nodes of a container draw on
+	// the pool its caller handed in. Requests for more than one object go
+	// straight to operator new;
+	template <class T, std::size_t BlockNodes = 256>
+	class pool_allocator
+	{
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind {
+			typedef pool_allocator<U, BlockNodes>	other;
+		};
+
+	private:
+		template <class U, std::size_t M>
+		friend class pool_allocator;
+
+		typedef pool_allocator_class	pool_class;
+		typedef pool_allocator_state	pool_state;
+
+		pool_state*	pool;
+		pool_class*	slots;
+
+		static size_type	slot_size() {
+			const size_type	align = __alignof__(T) > __alignof__(void*) ? __alignof__(T) : __alignof__(void*);
+			const size_type	size = sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*);
+			return (size + align - 1) / align * align;
+		}
+
+		static pool_state*	new_pool() {
+			pool_state*	p = static_cast<pool_state*>(::operator new(sizeof(pool_state)));
+			p->refs = 1;
+			p->classes = 0;
+			p->blocks = 0;
+			p->reserved = 0;
+			return p;
+		}
+
+		// types of the same slot size share their free list;
+		static pool_class*	class_of(pool_state* p) {
+			pool_class*	c = p->classes;
+			while (c != 0 && c->slot != slot_size()) {
+				c = c->next;
+			}
+			if (c == 0) {
+				c = static_cast<pool_class*>(::operator new(sizeof(pool_class)));
+				c->next = p->classes;
+				c->slot = slot_size();
+				c->free_list = 0;
+				c->cursor = 0;
+				c->limit = 0;
+				p->classes = c;
+			}
+			return c;
+		}
+
+		void				release_pool() {
+			if (--pool->refs != 0) {
+				return ;
+			}
+			void*	block = pool->blocks;
+			while (block != 0) {
+				void*	next = *static_cast<void**>(block);
+				::operator delete(block);
+				block = next;
+			}
+			while (pool->classes != 0) {
+				pool_class*	next = pool->classes->next;
+				::operator delete(pool->classes);
+				pool->classes = next;
+			}
+			::operator delete(pool);
+		}
+
+		// the first slot of every block links it into pool->blocks;
+		void				grow() {
+			const size_type	bytes = slot_size() * (BlockNodes + 1);
+			char*			block = static_cast<char*>(::operator new(bytes));
+			*reinterpret_cast<void**>(block) = pool->blocks;
+			pool->blocks = block;
+			slots->cursor = block + slot_size();
+			slots->limit = block + bytes;
+			pool->reserved += bytes;
+		}
+
+	public:
+		pool_allocator()
+		: pool(new_pool()), slots(0) {
+			try
+			{
+				slots = class_of(pool);
+			}
+			catch(...)
+			{
+				::operator delete(pool);
+				throw;
+			}
+		}
+
+		pool_allocator(const pool_allocator& x)
+		: pool(x.pool), slots(x.slots) {
+			++pool->refs;
+		}
+
+		template <class U>
+		pool_allocator(const pool_allocator<U, BlockNodes>& x)
+		: pool(x.pool), slots(class_of(x.pool)) {
+			++pool->refs;
+		}
+
+		~pool_allocator() {
+			release_pool();
+		}
+
+		pool_allocator&	operator=(const pool_allocator& x) {
+			++x.pool->refs;
+			release_pool();
+			pool = x.pool;
+			slots = x.slots;
+			return *this;
+		}
+
+		pointer			address(reference x) const {
+			return &x;
+		}
+
+		const_pointer	address(const_reference x) const {
+			return &x;
+		}
+
+		pointer			allocate(size_type n, const void* = 0) {
+			if (n != 1) {
+				if (n > max_size()) {
+					throw std::bad_alloc();
+				}
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			}
+			if (slots->free_list != 0) {
+				void*	p = slots->free_list;
+				slots->free_list = *static_cast<void**>(p);
+				return static_cast<pointer>(p);
+			}
+			if (slots->cursor == slots->limit) {
+				grow();
+			}
+			void*	p = slots->cursor;
+			slots->cursor += slot_size();
+			return static_cast<pointer>(p);
+		}
+
+		void			deallocate(pointer p, size_type n) {
+			if (n != 1) {
+				::operator delete(static_cast<void*>(p));
+				return ;
+			}
+			*reinterpret_cast<void**>(p) = slots->free_list;
+			slots->free_list = static_cast<void*>(p);
+		}
+
+		size_type		max_size() const {
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		void			construct(pointer p, const T& val) {
+			new(static_cast<void*>(p)) T(val);
+		}
+
+		void			destroy(pointer p) {
+			p->~T();
+		}
+
+		// bytes held in blocks by this pool, for every slot size and
+		// whether in use or not;
+		size_type		reserved_bytes() const {
+			return pool->reserved;
+		}
+
+		template <class U>
+		bool			shares_pool(const pool_allocator<U, BlockNodes>& x) const {
+			return pool == x.pool;
+		}
+	};
+
+	// equal when rebound to a common type either frees what the other
+	// allocated, which holds whenever they share a pool;
+	template <class T, class U, std::size_t N>
+	bool	operator==(const pool_allocator<T, N>& x, const pool_allocator<U, N>& y) {
+		return x.shares_pool(y);
+	}
+
+	template <class T, class U, std::size_t N>
+	bool	operator!=(const pool_allocator<T, N>& x, const pool_allocator<U, N>& y) {
+		return !(x == y);
+	}
+}
+
+#endif
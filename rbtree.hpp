@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <algorithm>
+#include <limits>
+#include <stdint.h>
+#include <utility>
 #include "algobase.hpp"
 #include "iterator.hpp"
 
@@ -18,14 +21,39 @@ namespace ft
 		right
 	};
 
+	enum rb_tree_set_operation {
+		set_union_op,
+		set_intersection_op,
+		set_difference_op,
+		set_symmetric_difference_op
+	};
+
+	// the links come first so they sit at the same offsets whatever Val
+	// is; the color lives in the low bit of the parent pointer, which
+	// node alignment always leaves clear;
 	template <class Val>
 	struct rb_tree_node
 	{
-		Val							value_field;
-		rb_tree_color				color;
-		rb_tree_node<Val>*			parent;
 		rb_tree_node<Val>*			left;
 		rb_tree_node<Val>*			right;
+		uintptr_t					parent_color;
+		Val							value_field;
+
+		rb_tree_node<Val>*	parent() const {
+			return reinterpret_cast<rb_tree_node<Val>*>(parent_color & ~uintptr_t(1));
+		}
+
+		void				set_parent(rb_tree_node<Val>* p) {
+			parent_color = reinterpret_cast<uintptr_t>(p) | (parent_color & uintptr_t(1));
+		}
+
+		rb_tree_color		color() const {
+			return rb_tree_color(parent_color & uintptr_t(1));
+		}
+
+		void				set_color(rb_tree_color c) {
+			parent_color = (parent_color & ~uintptr_t(1)) | uintptr_t(c);
+		}
 
 		static rb_tree_node<Val>*	minimum(rb_tree_node<Val>* x) {
 			while (x->left != 0) {
@@ -42,7 +70,256 @@ namespace ft
 		}
 	};
 
-	template<class Val, class Ref, class Ptr>
+	// augmentation policies: each node carries a data_type that update()
+	// recomputes from the node's value and its children's data (0 for a
+	// missing child), bottom-up, whenever the subtree under it changes.
+	// A counts_nodes policy keeps the subtree size there, which lets
+	// nth(), rank() and distance() run in O(log n). Every policy is also
+	// a monoid over the values (identity, lift, combine) whose subtree
+	// total value() gives aggregate() in O(log n); an unaugmented tree
+	// folds the same monoid over the range instead. A reads_values
+	// policy depends on more than the keys, so a map built on it only
+	// lets the mapped values change through update();
+	struct rb_tree_no_augment
+	{
+		struct data_type {};
+		typedef size_t	result_type;
+
+		static const bool	augmented = false;
+		static const bool	counts_nodes = false;
+		static const bool	reads_values = false;
+		static const bool	threaded = false;
+		static const bool	prefetches = false;
+
+		template <class Val>
+		static void		update(data_type&, const Val&, const data_type*, const data_type*) {}
+
+		static size_t	size(const data_type&) {
+			return 0;
+		}
+
+		static result_type	identity() {
+			return 0;
+		}
+
+		template <class Val>
+		static result_type	lift(const Val&) {
+			return 1;
+		}
+
+		static result_type	combine(result_type x, result_type y) {
+			return x + y;
+		}
+
+		static result_type	value(const data_type&) {
+			return 0;
+		}
+	};
+
+	struct rb_tree_size_augment
+	{
+		typedef size_t	data_type;
+		typedef size_t	result_type;
+
+		static const bool	augmented = true;
+		static const bool	counts_nodes = true;
+		static const bool	reads_values = false;
+		static const bool	threaded = false;
+		static const bool	prefetches = false;
+
+		template <class Val>
+		static void		update(data_type& d, const Val&, const data_type* l, const data_type* r) {
+			d = 1 + (l != 0 ? *l : 0) + (r != 0 ? *r : 0);
+		}
+
+		static size_t	size(const data_type& d) {
+			return d;
+		}
+
+		static result_type	identity() {
+			return 0;
+		}
+
+		template <class Val>
+		static result_type	lift(const Val&) {
+			return 1;
+		}
+
+		static result_type	combine(result_type x, result_type y) {
+			return x + y;
+		}
+
+		static result_type	value(const data_type& d) {
+			return d;
+		}
+	};
+
+	// a user monoid: Monoid is default constructible and provides
+	// result_type, identity(), lift(const Val&) and combine(x, y), where
+	// combine is associative but need not commute (it is always applied
+	// in key order). The subtree size is kept alongside, so the order
+	// statistics stay O(log n) too;
+	template <class Monoid>
+	struct rb_tree_monoid_augment
+	{
+		typedef typename Monoid::result_type	result_type;
+
+		struct data_type {
+			size_t		size;
+			result_type	value;
+		};
+
+		static const bool	augmented = true;
+		static const bool	counts_nodes = true;
+		static const bool	reads_values = true;
+		static const bool	threaded = false;
+		static const bool	prefetches = false;
+
+		template <class Val>
+		static void		update(data_type& d, const Val& v, const data_type* l, const data_type* r) {
+			Monoid		m;
+			result_type	x = m.lift(v);
+
+			d.size = 1;
+			if (l != 0) {
+				d.size += l->size;
+				x = m.combine(l->value, x);
+			}
+			if (r != 0) {
+				d.size += r->size;
+				x = m.combine(x, r->value);
+			}
+			d.value = x;
+		}
+
+		static size_t	size(const data_type& d) {
+			return d.size;
+		}
+
+		static result_type	identity() {
+			return Monoid().identity();
+		}
+
+		template <class Val>
+		static result_type	lift(const Val& v) {
+			return Monoid().lift(v);
+		}
+
+		static result_type	combine(const result_type& x, const result_type& y) {
+			return Monoid().combine(x, y);
+		}
+
+		static result_type	value(const data_type& d) {
+			return d.value;
+		}
+	};
+
+	// wraps another policy and has the tree keep in-order next and prev
+	// links in every node as well, so that ++ and -- are a single load.
+	// Costs two pointers a node and their upkeep on insert and erase; the
+	// set operations always take the linear merge, which relinks anyway;
+	template <class Augment = rb_tree_no_augment>
+	struct rb_tree_threaded : public Augment
+	{
+		static const bool	threaded = true;
+	};
+
+	// wraps another policy and has find(), lower_bound() and upper_bound()
+	// prefetch both children of a node before comparing against it, so
+	// the next level's cache miss overlaps the compare. Pays off once the
+	// tree outgrows the cache; below that it only spends bandwidth;
+	template <class Augment = rb_tree_no_augment>
+	struct rb_tree_prefetching : public Augment
+	{
+		static const bool	prefetches = true;
+	};
+
+	// what the tree actually allocates; iterators only ever see the base;
+	template <class Val, class Data>
+	struct rb_tree_augmented_node : public rb_tree_node<Val>
+	{
+		Data	augment;
+
+		Data&	data() {
+			return augment;
+		}
+	};
+
+	// the empty policy data is an empty base, so it takes no room;
+	template <class Val>
+	struct rb_tree_augmented_node<Val, rb_tree_no_augment::data_type>
+	: public rb_tree_node<Val>, public rb_tree_no_augment::data_type
+	{
+		rb_tree_no_augment::data_type&	data() {
+			return *this;
+		}
+	};
+
+	template <class Val, class Data>
+	struct rb_tree_threaded_node : public rb_tree_augmented_node<Val, Data>
+	{
+		rb_tree_node<Val>*	next;
+		rb_tree_node<Val>*	prev;
+	};
+
+	// the node type for a policy, and thread_type, the node type the
+	// iterators follow in-order links through (void when unthreaded);
+	template <class Val, class Augment, bool Threaded = Augment::threaded>
+	struct rb_tree_node_select
+	{
+		typedef rb_tree_augmented_node<Val, typename Augment::data_type>	type;
+		typedef void														thread_type;
+	};
+
+	template <class Val, class Augment>
+	struct rb_tree_node_select<Val, Augment, true>
+	{
+		typedef rb_tree_threaded_node<Val, typename Augment::data_type>	type;
+		typedef type														thread_type;
+	};
+
+	template <class Thread>
+	struct rb_tree_thread_traits
+	{
+		static const bool	threaded = true;
+
+		template <class Link>
+		static Link	next(Link x) {
+			return static_cast<Thread*>(x)->next;
+		}
+
+		template <class Link>
+		static Link	prev(Link x) {
+			return static_cast<Thread*>(x)->prev;
+		}
+
+		template <class Link>
+		static void	link(Link x, Link y) {
+			static_cast<Thread*>(x)->next = y;
+			static_cast<Thread*>(y)->prev = x;
+		}
+	};
+
+	template <>
+	struct rb_tree_thread_traits<void>
+	{
+		static const bool	threaded = false;
+
+		template <class Link>
+		static Link	next(Link x) {
+			return x;
+		}
+
+		template <class Link>
+		static Link	prev(Link x) {
+			return x;
+		}
+
+		template <class Link>
+		static void	link(Link, Link) {}
+	};
+
+	template<class Val, class Ref, class Ptr, class Thread = void>
 	struct rb_tree_iterator
 	{
 		typedef std::bidirectional_iterator_tag					iterator_category;
@@ -50,24 +327,27 @@ namespace ft
 		typedef Val												value_type;
 		typedef Ref												reference;
 		typedef Ptr												pointer;
-		typedef rb_tree_iterator<Val, Val&, Val*>				iterator;
-		typedef rb_tree_iterator<Val, const Val&, const Val*>	const_iterator;
-		typedef rb_tree_iterator<Val, Ref, Ptr>					self;
-		typedef rb_tree_node<Val>*								link_type;
+		typedef rb_tree_iterator<Val, Val&, Val*, Thread>				iterator;
+		typedef rb_tree_iterator<Val, const Val&, const Val*, Thread>	const_iterator;
+		typedef rb_tree_iterator<Val, Ref, Ptr, Thread>					self;
+		typedef rb_tree_node<Val>*										link_type;
+		typedef rb_tree_thread_traits<Thread>							thread_traits;
 
 		link_type	node;
 
 		void	increment() {
-			if (node->right != 0) {
+			if (thread_traits::threaded) {
+				node = thread_traits::next(node);
+			} else if (node->right != 0) {
 				node = node->right;
 				while (node->left != 0) {
 					node = node->left;
 				}
 			} else {
-				link_type	y = node->parent;
+				link_type	y = node->parent();
 				while (node == y->right) {
 					node = y;
-					y = y->parent;
+					y = y->parent();
 				}
 				if (node->right != y) {
 					node = y;
@@ -76,7 +356,9 @@ namespace ft
 		}
 
 		void	decrement() {
-			if (node->color == red && node->parent->parent == node) {
+			if (thread_traits::threaded) {
+				node = thread_traits::prev(node);
+			} else if (node->color() == red && node->parent()->parent() == node) {
 				node = node->right;
 			} else if (node->left != 0) {
 				link_type	y = node->left;
@@ -85,10 +367,10 @@ namespace ft
 				}
 				node = y;
 			} else {
-				link_type	y = node->parent;
+				link_type	y = node->parent();
 				while (node == y->left) {
 					node = y;
-					y = y->parent;
+					y = y->parent();
 				}
 				node = y;
 			}
@@ -96,7 +378,9 @@ namespace ft
 
 		rb_tree_iterator() {}
 		rb_tree_iterator(link_type x) { node = x; }
-		rb_tree_iterator(const iterator& it) { node = it.node; }
+		// iterator -> const_iterator; a template, so it never acts as the copy ctor;
+		template <class V>
+		rb_tree_iterator(const rb_tree_iterator<V, V&, V*, Thread>& it) { node = it.node; }
 
 		reference	operator*() const { return node->value_field; }
 		pointer		operator->() const { return &(operator*()); }
@@ -123,47 +407,51 @@ namespace ft
 		}
 	};
 
-	template <class Val, class Ref, class Ptr>
-	bool	operator==(const rb_tree_iterator<Val, Ref, Ptr>& x, \
-	const rb_tree_iterator<Val, Ref, Ptr>& y) {
+	template <class Val, class Ref, class Ptr, class Thread>
+	bool	operator==(const rb_tree_iterator<Val, Ref, Ptr, Thread>& x, \
+	const rb_tree_iterator<Val, Ref, Ptr, Thread>& y) {
 		return x.node == y.node;
 	}
 
-	template <class Val>
-	bool	operator==(const rb_tree_iterator<Val, const Val&, const Val*>& x, \
-	const rb_tree_iterator<Val, Val&, Val*>& y) {
+	template <class Val, class Thread>
+	bool	operator==(const rb_tree_iterator<Val, const Val&, const Val*, Thread>& x, \
+	const rb_tree_iterator<Val, Val&, Val*, Thread>& y) {
 		return x.node == y.node;
 	}
 
-	template <class Val>
-	bool	operator==(const rb_tree_iterator<Val, Val&, Val*>& x, \
-	const rb_tree_iterator<Val, const Val&, const Val*>& y) {
+	template <class Val, class Thread>
+	bool	operator==(const rb_tree_iterator<Val, Val&, Val*, Thread>& x, \
+	const rb_tree_iterator<Val, const Val&, const Val*, Thread>& y) {
 		return x.node == y.node;
 	}
 
-	template <class Val, class Ref, class Ptr>
-	bool	operator!=(const rb_tree_iterator<Val, Ref, Ptr>& x, \
-	const rb_tree_iterator<Val, Ref, Ptr>& y) {
+	template <class Val, class Ref, class Ptr, class Thread>
+	bool	operator!=(const rb_tree_iterator<Val, Ref, Ptr, Thread>& x, \
+	const rb_tree_iterator<Val, Ref, Ptr, Thread>& y) {
 		return x.node != y.node;
 	}
 
-	template <class Val>
-	bool	operator!=(const rb_tree_iterator<Val, const Val&, const Val*>& x, \
-	const rb_tree_iterator<Val, Val&, Val*>& y) {
+	template <class Val, class Thread>
+	bool	operator!=(const rb_tree_iterator<Val, const Val&, const Val*, Thread>& x, \
+	const rb_tree_iterator<Val, Val&, Val*, Thread>& y) {
 		return x.node != y.node;
 	}
 
-	template <class Val>
-	bool	operator!=(const rb_tree_iterator<Val, Val&, Val*>& x, \
-	const rb_tree_iterator<Val, const Val&, const Val*>& y) {
+	template <class Val, class Thread>
+	bool	operator!=(const rb_tree_iterator<Val, Val&, Val*, Thread>& x, \
+	const rb_tree_iterator<Val, const Val&, const Val*, Thread>& y) {
 		return x.node != y.node;
 	}
 
 	template<class Key, class Val, class KeyOfVal, class Compare, \
-	class Alloc >
+	class Alloc, class Augment = rb_tree_no_augment >
 	class rbtree {
 	protected:
-		typedef rb_tree_node<Val>	node_type;
+		typedef rb_tree_node<Val>											node_type;
+		typedef typename Augment::data_type									augment_type;
+		typedef typename rb_tree_node_select<Val, Augment>::type			augmented_node_type;
+		typedef typename rb_tree_node_select<Val, Augment>::thread_type		thread_type;
+		typedef rb_tree_thread_traits<thread_type>							thread_traits;
 
 	public:
 		typedef Key																key_type;
@@ -177,13 +465,132 @@ namespace ft
 		typedef ptrdiff_t														difference_type;
 		typedef Alloc															allocator_type;
 
-		typedef typename Alloc::template rebind<node_type>::other				node_allocator_type;
+		typedef typename Alloc::template rebind<augmented_node_type>::other	node_allocator_type;
 
-		typedef rb_tree_iterator<value_type, reference, pointer>				iterator;
-		typedef rb_tree_iterator<value_type, const_reference, const_pointer>	const_iterator;
+		typedef rb_tree_iterator<value_type, reference, pointer, thread_type>				iterator;
+		typedef rb_tree_iterator<value_type, const_reference, const_pointer, thread_type>	const_iterator;
 		typedef ft::reverse_iterator<iterator>									reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
 
+		// an element unlinked by extract(), still owning its node and a copy
+		// of the allocators that made it, so that insert() can link it into
+		// another tree as is. Move only; in C++98 a copy hands the node
+		// over, as auto_ptr does;
+		class node_handle
+		{
+			friend class rbtree;
+
+		public:
+			typedef Key		key_type;
+			typedef Val		value_type;
+			typedef Alloc	allocator_type;
+
+		private:
+			mutable link_type	node;
+			node_allocator_type	node_alloc;
+			allocator_type		data_alloc;
+
+			node_handle(link_type x, const node_allocator_type& na, const allocator_type& da)
+			: node(x), node_alloc(na), data_alloc(da) {}
+
+			link_type	release() const {
+				link_type	x = node;
+				node = 0;
+				return x;
+			}
+
+			void		reset() {
+				if (node != 0) {
+					augmented_node_type*	p = static_cast<augmented_node_type*>(node);
+					data_alloc.destroy(&(node->value_field));
+					p->data().~augment_type();
+					node_alloc.deallocate(p, 1);
+					node = 0;
+				}
+			}
+
+		public:
+			node_handle()
+			: node(0), node_alloc(), data_alloc() {}
+
+#if __cplusplus >= 201103L
+			node_handle(node_handle&& x) noexcept
+			: node(x.release()), node_alloc(x.node_alloc), data_alloc(x.data_alloc) {}
+
+			node_handle&	operator=(node_handle&& x) {
+				if (this != &x) {
+					reset();
+					node = x.release();
+					node_alloc = x.node_alloc;
+					data_alloc = x.data_alloc;
+				}
+				return *this;
+			}
+
+			node_handle(const node_handle&) = delete;
+			node_handle&	operator=(const node_handle&) = delete;
+#else
+			node_handle(const node_handle& x)
+			: node(x.release()), node_alloc(x.node_alloc), data_alloc(x.data_alloc) {}
+
+			node_handle&	operator=(const node_handle& x) {
+				if (this != &x) {
+					reset();
+					node = x.release();
+					node_alloc = x.node_alloc;
+					data_alloc = x.data_alloc;
+				}
+				return *this;
+			}
+#endif
+
+			~node_handle() {
+				reset();
+			}
+
+			bool			empty() const {
+				return node == 0;
+			}
+
+			allocator_type	get_allocator() const {
+				return data_alloc;
+			}
+
+			value_type&		value() const {
+				return node->value_field;
+			}
+
+			// the node is out of any tree, so the key may be changed;
+			key_type&		key() const {
+				return const_cast<key_type&>(KeyOfVal()(node->value_field));
+			}
+
+			void			swap(node_handle& x) {
+				std::swap(node, x.node);
+				std::swap(node_alloc, x.node_alloc);
+				std::swap(data_alloc, x.data_alloc);
+			}
+		};
+
+#if __cplusplus >= 201103L
+		typedef node_handle&&		node_handle_arg;
+#else
+		typedef const node_handle&	node_handle_arg;
+#endif
+
+		template <class Iterator>
+		struct node_insert_return
+		{
+			Iterator	position;
+			bool		inserted;
+			node_handle	node;
+
+			node_insert_return(Iterator pos, bool ins, node_handle_arg nh)
+			: position(pos), inserted(ins), node(static_cast<node_handle_arg>(nh)) {}
+		};
+
+		typedef node_insert_return<iterator>	insert_return_type;
+
 	protected:
 		allocator_type		data_allocator;
 		node_allocator_type	node_allocator;
@@ -196,15 +603,16 @@ namespace ft
 		}
 
 		void		put_node(link_type target) {
-			return node_allocator.deallocate(target, 1);
+			return node_allocator.deallocate(static_cast<augmented_node_type*>(target), 1);
 		}
 
-		link_type	create_node(const value_type& x) {
+		// element nodes also own their augment data, the header does not;
+		link_type	get_augmented_node() {
 			link_type	tmp = get_node();
 
 			try
 			{
-				data_allocator.construct(&(tmp->value_field ), x);
+				::new(static_cast<void*>(&s_augment(tmp))) augment_type();
 			}
 			catch(...)
 			{
@@ -214,9 +622,49 @@ namespace ft
 			return tmp;
 		}
 
+		void		put_augmented_node(link_type target) {
+			s_augment(target).~augment_type();
+			put_node(target);
+		}
+
+#if __cplusplus >= 201103L
+		template <class... Args>
+		link_type	create_node(Args&&... args) {
+			link_type	tmp = get_augmented_node();
+
+			try
+			{
+				std::allocator_traits<allocator_type>::construct(data_allocator, \
+				&(tmp->value_field), std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				put_augmented_node(tmp);
+				throw;
+			}
+			return tmp;
+		}
+#else
+		link_type	create_node(const value_type& x) {
+			link_type	tmp = get_augmented_node();
+
+			try
+			{
+				data_allocator.construct(&(tmp->value_field ), x);
+			}
+			catch(...)
+			{
+				put_augmented_node(tmp);
+				throw;
+			}
+			return tmp;
+		}
+#endif
+
 		link_type	clone_node(link_type x) {
 			link_type	tmp = create_node(x->value_field);
-			tmp->color = x->color;
+			tmp->set_color(x->color());
+			s_augment(tmp) = s_augment(x);
 			tmp->left = 0;
 			tmp->right = 0;
 			return tmp;
@@ -224,11 +672,15 @@ namespace ft
 
 		void	destroy_node(link_type p) {
 			data_allocator.destroy(&(p->value_field));
-			put_node(p);
+			put_augmented_node(p);
 		}
 
-		link_type&	root() const {
-			return (link_type&)header->parent;
+		link_type	root() const {
+			return header->parent();
+		}
+
+		void		set_root(link_type x) {
+			header->set_parent(x);
 		}
 
 		link_type&	leftmost() const {
@@ -247,8 +699,8 @@ namespace ft
 			return (link_type&)x->right;
 		}
 
-		static link_type&	s_parent(link_type x) {
-			return (link_type&)x->parent;
+		static link_type	s_parent(link_type x) {
+			return x->parent();
 		}
 
 		static reference	s_value(link_type x) {
@@ -259,8 +711,8 @@ namespace ft
 			return KeyOfVal()(s_value(x));
 		}
 
-		static rb_tree_color&	s_color(link_type x) {
-			return x->color;
+		static rb_tree_color	s_color(link_type x) {
+			return x->color();
 		}
 
 		static link_type	s_minimum(link_type x) {
@@ -271,6 +723,72 @@ namespace ft
 			return (link_type)rb_tree_node<Val>::maximum(x);
 		}
 
+		// a hint only: x may be 0;
+		static void		s_prefetch(link_type x) {
+#if defined(__GNUC__)
+			__builtin_prefetch(x);
+#else
+			(void)x;
+#endif
+		}
+
+		static void		s_prefetch_children(link_type x) {
+			if (Augment::prefetches) {
+				s_prefetch(s_left(x));
+				s_prefetch(s_right(x));
+			}
+		}
+
+		static augment_type&	s_augment(link_type x) {
+			return static_cast<augmented_node_type*>(x)->data();
+		}
+
+		static size_type	s_size(link_type x) {
+			return (x == 0) ? 0 : Augment::size(s_augment(x));
+		}
+
+		static typename Augment::result_type	s_total(link_type x) {
+			return (x == 0) ? Augment::identity() : Augment::value(s_augment(x));
+		}
+
+		static void		s_update(link_type x) {
+			Augment::update(s_augment(x), s_value(x), \
+			(x->left != 0) ? &s_augment(x->left) : 0, \
+			(x->right != 0) ? &s_augment(x->right) : 0);
+		}
+
+		// refresh x and everything above it; a detached subtree ends at 0;
+		void		augment_path(link_type x) {
+			if (Augment::augmented) {
+				for (; x != 0 && x != header; x = x->parent()) {
+					s_update(x);
+				}
+			}
+		}
+
+		// in-order links of a threaded tree, a ring through the header;
+		// these are no-ops otherwise;
+		static void	s_thread(link_type x, link_type y) {
+			thread_traits::link(x, y);
+		}
+
+		void		thread_ends() {
+			s_thread(header, leftmost());
+			s_thread(rightmost(), header);
+		}
+
+		// relinks every node from the tree links, O(n);
+		void		rethread() {
+			if (thread_traits::threaded) {
+				link_type	p = header;
+				for (rb_tree_iterator<Val, Val&, Val*> it(leftmost()); it.node != header; ++it) {
+					s_thread(p, it.node);
+					p = it.node;
+				}
+				s_thread(p, header);
+			}
+		}
+
 	public:
 		allocator_type	get_allocator() const {
 			return node_allocator;
@@ -278,73 +796,101 @@ namespace ft
 
 		// allocator, deallocator;
 		rbtree()
-		: data_allocator(allocator_type()), node_allocator(node_allocator_type()), \
+		: data_allocator(allocator_type()), node_allocator(data_allocator), \
 		header(get_node()), node_count(0), key_compare(){
-			s_color(header) = red;
-			root() = 0;
+			header->set_color(red);
+			set_root(0);
 			leftmost() = header;
 			rightmost() = header;
+			thread_ends();
 		}
 
 		rbtree(const Compare& comp)
-		: data_allocator(allocator_type()), node_allocator(node_allocator_type()), \
+		: data_allocator(allocator_type()), node_allocator(data_allocator), \
 		header(get_node()), node_count(0), key_compare(comp) {
-			s_color(header) = red;
-			root() = 0;
+			header->set_color(red);
+			set_root(0);
 			leftmost() = header;
 			rightmost() = header;
+			thread_ends();
 		}
 
 		rbtree(const Compare& comp, const allocator_type& a)
-		: data_allocator(a), node_allocator(node_allocator_type()), \
+		: data_allocator(a), node_allocator(data_allocator), \
 		header(get_node()), node_count(0), key_compare(comp) {
-			s_color(header) = red;
-			root() = 0;
+			header->set_color(red);
+			set_root(0);
 			leftmost() = header;
 			rightmost() = header;
+			thread_ends();
 		}
 
-		rbtree(const rbtree<Key, Val, KeyOfVal, Compare, Alloc>& x)
-		: data_allocator(x.get_allocator()), node_allocator(node_allocator_type()), \
+		rbtree(const rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>& x)
+		: data_allocator(x.get_allocator()), node_allocator(data_allocator), \
 		header(get_node()), node_count(0), key_compare(x.key_compare) {
 			if (x.root() == 0) {
-				s_color(header) = red;
-				root() = 0;
+				header->set_color(red);
+				set_root(0);
 				leftmost() = header;
 				rightmost() = header;
 			} else {
-				s_color(header) = red;
-				root() = rb_copy(x.root(), header);
+				header->set_color(red);
+				set_root(rb_copy(x.root(), header));
 				leftmost() = s_minimum(root());
 				rightmost() = s_maximum(root());
 			}
 			node_count = x.node_count;
+			rethread();
+		}
+
+#if __cplusplus >= 201103L
+		rbtree(rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>&& x)
+		: data_allocator(x.data_allocator), node_allocator(x.node_allocator), \
+		header(get_node()), node_count(0), key_compare(x.key_compare) {
+			header->set_color(red);
+			set_root(0);
+			leftmost() = header;
+			rightmost() = header;
+			thread_ends();
+			swap(x);
 		}
+#endif
 
 		~rbtree() {
 			clear();
 			put_node(header);
 		}
 
-		rbtree<Key, Val, KeyOfVal, Compare, Alloc>&	operator=(const rbtree<Key, Val, KeyOfVal, Compare, Alloc>& x) {
+		rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>&	operator=(const rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>& x) {
 			if (this != &x) {
 				clear();
 				node_count = 0;
 				key_compare = x.key_compare;
 				if (x.root() == 0) {
-					root() = 0;
+					set_root(0);
 					leftmost() = header;
 					rightmost() = header;
 				} else {
-					root() = rb_copy(x.root(), header);
+					set_root(rb_copy(x.root(), header));
 					leftmost() = s_minimum(root());
 					rightmost() = s_maximum(root());
 					node_count = x.node_count;
+					rethread();
 				}
 			}
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>&	operator=(rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>&& x) {
+			if (this != &x) {
+				clear();
+				swap(x);
+			}
+			return *this;
+		}
+#endif
+
 		// Accessors;
 		Compare	key_comp() const {
 			return key_compare;
@@ -394,7 +940,11 @@ namespace ft
 			return std::min<size_type>(node_allocator.max_size(), std::numeric_limits<difference_type>::max());
 		}
 
-		void	swap(rbtree<Key, Val, KeyOfVal, Compare, Alloc>& t) {
+		// nodes stay with the allocator that made them, which matters once
+		// that allocator is stateful (pool_allocator);
+		void	swap(rbtree<Key, Val, KeyOfVal, Compare, Alloc, Augment>& t) {
+			std::swap(data_allocator, t.data_allocator);
+			std::swap(node_allocator, t.node_allocator);
 			std::swap(header, t.header);
 			std::swap(node_count, t.node_count);
 			std::swap(key_compare, t.key_compare);
@@ -402,91 +952,147 @@ namespace ft
 
 		// Insert/Erase;
 		ft::pair<iterator,bool>	insert(const value_type& v) {
-			link_type	y = header;
-			link_type	x = root();
-			bool		comp = true;
-			while (x != 0) {
-				y = x;
-				comp = key_compare(KeyOfVal()(v), s_key(x));
-				if (comp) {
-					x = s_left(x);
-				} else {
-					x = s_right(x);
-				}
-			}
-			iterator	j = iterator(y);
-			if (comp) {
-				if (j == begin()) {
-					return ft::pair<iterator, bool>(rb_insert(x, y, v), true);
-				} else {
-					--j;
-				}
-			}
-			if (key_compare(s_key(j.node), KeyOfVal()(v))) {
-				return ft::pair<iterator, bool>(rb_insert(x, y, v), true);
+			ft::pair<link_type, link_type>	pos = get_insert_unique_pos(KeyOfVal()(v));
+
+			if (pos.second != 0) {
+				return ft::pair<iterator, bool>(rb_insert(pos.first, pos.second, v), true);
 			}
-			return ft::pair<iterator, bool>(j, false);
+			return ft::pair<iterator, bool>(iterator(pos.first), false);
 		}
 
 		iterator	insert(iterator position, const value_type& v) {
-			if (position.node == header->left) {
-				if (size() > 0 && key_compare(KeyOfVal()(v), s_key(position.node))) {
-					return rb_insert(position.node, position.node, v);
-				} else {
-					return insert(v).first;
-				}
-			} else if (position.node == header) {
-				if (key_compare(s_key(rightmost()), KeyOfVal()(v))) {
-					return rb_insert(0, rightmost(), v);
-				} else {
-					return insert(v).first;
-				}
-			} else {
-				iterator	before = position;
-				--before;
-				if (key_compare(s_key(before.node), KeyOfVal()(v)) && \
-				key_compare(KeyOfVal()(v), s_key(position.node))) {
-					if (s_right(before.node) == 0) {
-						return rb_insert(0, before.node, v);
-					} else {
-						return rb_insert(position.node, position.node, v);
-					}
-				} else {
-					return insert(v).first;
-				}
+			ft::pair<link_type, link_type>	pos = get_insert_hint_unique_pos(position, KeyOfVal()(v));
+
+			if (pos.second != 0) {
+				return rb_insert(pos.first, pos.second, v);
 			}
+			return iterator(pos.first);
 		}
 
-		template<class InputIterator>
-		void		insert(InputIterator first, InputIterator last) {
-			for (; first != last; ++first) {
-				insert(*first);
+#if __cplusplus >= 201103L
+		ft::pair<iterator,bool>	insert(value_type&& v) {
+			ft::pair<link_type, link_type>	pos = get_insert_unique_pos(KeyOfVal()(v));
+
+			if (pos.second != 0) {
+				return ft::pair<iterator, bool>(link_node(pos.first, pos.second, create_node(std::move(v))), true);
 			}
+			return ft::pair<iterator, bool>(iterator(pos.first), false);
 		}
 
-		void		erase(iterator position) {
-			link_type	y = \
-			(link_type)rb_tree_rebalance_for_erase(position.node, \
-			header->parent, header->left, header->right);
-			destroy_node(y);
-			--node_count;
-		}
+		iterator	insert(iterator position, value_type&& v) {
+			ft::pair<link_type, link_type>	pos = get_insert_hint_unique_pos(position, KeyOfVal()(v));
 
-		size_type	erase(const key_type& x) {
-			ft::pair<iterator, iterator>	p = equal_range(x);
-			size_type	n = ft::distance(p.first, p.second);
-			erase(p.first, p.second);
-			return n;
+			if (pos.second != 0) {
+				return link_node(pos.first, pos.second, create_node(std::move(v)));
+			}
+			return iterator(pos.first);
 		}
 
+		// the node is built before the key can be looked at, so a
+		// duplicate costs one allocation that is immediately released;
+		template <class... Args>
+		ft::pair<iterator,bool>	emplace(Args&&... args) {
+			link_type						z = create_node(std::forward<Args>(args)...);
+			ft::pair<link_type, link_type>	pos;
+
+			try
+			{
+				pos = get_insert_unique_pos(s_key(z));
+			}
+			catch(...)
+			{
+				destroy_node(z);
+				throw;
+			}
+			if (pos.second != 0) {
+				return ft::pair<iterator, bool>(link_node(pos.first, pos.second, z), true);
+			}
+			destroy_node(z);
+			return ft::pair<iterator, bool>(iterator(pos.first), false);
+		}
+
+		template <class... Args>
+		iterator	emplace_hint(iterator position, Args&&... args) {
+			link_type						z = create_node(std::forward<Args>(args)...);
+			ft::pair<link_type, link_type>	pos;
+
+			try
+			{
+				pos = get_insert_hint_unique_pos(position, s_key(z));
+			}
+			catch(...)
+			{
+				destroy_node(z);
+				throw;
+			}
+			if (pos.second != 0) {
+				return link_node(pos.first, pos.second, z);
+			}
+			destroy_node(z);
+			return iterator(pos.first);
+		}
+#endif
+
+		// an empty tree takes the strictly ascending prefix of the input in
+		// O(n); whatever follows is inserted with an end() hint, which is
+		// O(1) amortized as long as it keeps ascending;
+		template<class InputIterator>
+		void		insert(InputIterator first, InputIterator last) {
+			if (node_count == 0) {
+				first = build_from_sorted(first, last);
+			}
+			for (; first != last; ++first) {
+				insert(end(), *first);
+			}
+		}
+
+		void		erase(iterator position) {
+			destroy_node(unlink_node(position.node));
+		}
+
+		size_type	erase(const key_type& x) {
+			ft::pair<iterator, iterator>	p = equal_range(x);
+			size_type	n = distance(p.first, p.second);
+			erase(p.first, p.second);
+			return n;
+		}
+
+		// a range longer than the tree is high is cut out with two splits
+		// and a join, then freed in one pass: O(log n + k) and no per node
+		// rebalancing;
 		void		erase(iterator first, iterator last) {
 			if (first == begin() && last == end()) {
 				clear();
-			} else {
+				return ;
+			}
+			iterator	probe = first;
+			size_type	steps = 2 * black_height(root());
+
+			while (probe != last && steps-- != 0) {
+				++probe;
+			}
+			if (probe == last) {
 				while (first != last) {
 					erase(first++);
 				}
+				return ;
+			}
+			size_type	n = node_count;
+			free_tree	l;
+			link_type	m;
+			free_tree	r;
+			free_tree	doomed;
+			free_tree	tail;
+
+			s_thread(thread_traits::prev(first.node), last.node);
+			split_tree(detach_tree(), s_key(first.node), l, m, r);
+			doomed = join_trees(free_tree(), m, r);
+			if (last.node != header) {
+				split_tree(doomed, s_key(last.node), doomed, m, r);
+				tail = join_trees(free_tree(), m, r);
 			}
+			size_type	k = rb_erase(doomed.root);
+			attach_root(join_pair(l, tail).root, n - k);
 		}
 
 		void		erase(const key_type* first, const key_type* last) {
@@ -499,63 +1105,1089 @@ namespace ft
 			if (node_count != 0) {
 				rb_erase(root());
 				leftmost() = header;
-				root() = 0;
+				set_root(0);
 				rightmost() = header;
 				node_count = 0;
+				thread_ends();
 			}
 		}
 
+		// node handles: the node itself moves between trees, nothing is
+		// allocated or copied as long as the node allocators compare equal;
+		node_handle	extract(iterator position) {
+			return node_handle(unlink_node(position.node), node_allocator, data_allocator);
+		}
+
+		node_handle	extract(const key_type& k) {
+			link_type	x = find_node(k);
+
+			if (x == header) {
+				return node_handle(0, node_allocator, data_allocator);
+			}
+			return node_handle(unlink_node(x), node_allocator, data_allocator);
+		}
+
+		// on a duplicate key the handle comes back in the result;
+		insert_return_type	insert(node_handle_arg nh) {
+			if (nh.empty()) {
+				return insert_return_type(end(), false, static_cast<node_handle_arg>(nh));
+			}
+			ft::pair<link_type, link_type>	pos = get_insert_unique_pos(s_key(nh.node));
+
+			if (pos.second == 0) {
+				return insert_return_type(iterator(pos.first), false, static_cast<node_handle_arg>(nh));
+			}
+			iterator	it = link_node(pos.first, pos.second, adopt_node(nh));
+			return insert_return_type(it, true, static_cast<node_handle_arg>(nh));
+		}
+
+		// on a duplicate key nh keeps its node;
+		iterator	insert(iterator position, node_handle_arg nh) {
+			if (nh.empty()) {
+				return end();
+			}
+			ft::pair<link_type, link_type>	pos = get_insert_hint_unique_pos(position, s_key(nh.node));
+
+			if (pos.second == 0) {
+				return iterator(pos.first);
+			}
+			return link_node(pos.first, pos.second, adopt_node(nh));
+		}
+
+		// moves the elements not less than k into upper, whose contents are
+		// dropped and which takes over this tree's allocators. O(log n),
+		// plus a count of the smaller side unless Augment counts nodes;
+		void		split(const key_type& k, rbtree& upper) {
+			if (&upper == this) {
+				return ;
+			}
+			upper.clear();
+			if (!(upper.node_allocator == node_allocator)) {
+				// the header moves too, its old allocator may be the last
+				// one holding its memory;
+				node_allocator_type	na(node_allocator);
+				link_type			h = na.allocate(1);
+				upper.put_node(upper.header);
+				upper.node_allocator = na;
+				upper.header = h;
+				upper.header->set_color(red);
+				upper.attach_root(0, 0);
+			}
+			upper.data_allocator = data_allocator;
+			upper.key_compare = key_compare;
+			if (node_count == 0) {
+				return ;
+			}
+			size_type	n = node_count;
+			free_tree	l;
+			link_type	m;
+			free_tree	r;
+
+			split_tree(detach_tree(), k, l, m, r);
+			if (m != 0) {
+				r = join_trees(free_tree(), m, r);
+			}
+			size_type	upper_n = Augment::counts_nodes ? s_size(r.root) : count_upper(l.root, r.root, n);
+			attach_root(l.root, n - upper_n);
+			upper.attach_root(r.root, upper_n);
+		}
+
+		// appends other, whose keys must all be greater than ours, and
+		// leaves it empty. O(log n) when the node allocators compare equal;
+		// otherwise the elements are copied;
+		void		join(rbtree& other) {
+			if (&other == this || other.node_count == 0) {
+				return ;
+			}
+			if (node_count != 0 && !key_compare(s_key(rightmost()), s_key(other.leftmost()))) {
+				std::__throw_invalid_argument("rbtree::join");
+			}
+			if (!(node_allocator == other.node_allocator)) {
+				for (iterator it = other.begin(); it != other.end(); ++it) {
+					insert(end(), *it);
+				}
+				other.clear();
+				return ;
+			}
+			link_type	k = other.unlink_node(other.leftmost());
+			size_type	n = node_count + other.node_count + 1;
+
+			s_thread(rightmost(), k);
+			s_thread(k, other.leftmost());
+			free_tree	l = detach_tree();
+			free_tree	r = other.detach_tree();
+
+			other.attach_root(0, 0);
+			attach_root(join_trees(l, k, r).root, n);
+		}
+
+		// relinks every node of source whose key is not here yet; with
+		// unequal allocators the element is copied over and erased there;
+		void		merge(rbtree& source) {
+			if (&source == this) {
+				return ;
+			}
+			link_type	x = source.leftmost();
+
+			while (x != source.header) {
+				iterator	next = iterator(x);
+				++next;
+				ft::pair<link_type, link_type>	pos = get_insert_unique_pos(s_key(x));
+				if (pos.second != 0) {
+					if (node_allocator == source.node_allocator) {
+						link_node(pos.first, pos.second, source.unlink_node(x));
+					} else {
+						link_node(pos.first, pos.second, create_node(s_value(x)));
+						source.erase(iterator(x));
+					}
+				}
+				x = next.node;
+			}
+		}
+
+		// *this = *this op other. When one side is far smaller the other is
+		// split at its keys and joined back, O(m log(n / m)); otherwise both
+		// are merged in order and the tree rebuilt from the node chain,
+		// O(n + m). Our nodes are kept, other's elements copied, before any
+		// of ours is touched: should a copy throw, the tree is left as it
+		// was. Both trees must order keys alike, and Compare must not throw;
+		void		set_operation(const rbtree& other, rb_tree_set_operation op) {
+			if (&other == this) {
+				if (op == set_difference_op || op == set_symmetric_difference_op) {
+					clear();
+				}
+				return ;
+			}
+			if (!thread_traits::threaded && prefer_split_join(node_count, other.node_count)) {
+				split_join_operation(other, op);
+			} else {
+				merge_operation(other, op);
+			}
+		}
+
+		// *this = a op b, built from scratch; this tree may be neither.
+		// Where both hold equivalent elements, a's is the one copied;
+		void		assign_set_operation(const rbtree& a, const rbtree& b, rb_tree_set_operation op) {
+			clear();
+			if (!prefer_split_join(a.node_count, b.node_count)) {
+				merge_ranges(a, b, op);
+				return ;
+			}
+			const rbtree&	small = (a.node_count < b.node_count) ? a : b;
+			const rbtree&	big = (&small == &a) ? b : a;
+
+			if (op == set_intersection_op || (op == set_difference_op && &small == &a)) {
+				// the result lies within the smaller side: probe the other;
+				link_type	head = 0;
+				link_type	tail = 0;
+				size_type	n = 0;
+
+				try
+				{
+					for (const_iterator it = small.begin(); it != small.end(); ++it) {
+						link_type	y = big.find_node(KeyOfVal()(*it));
+						bool		found = (y != big.header);
+						if (found == (op == set_intersection_op)) {
+							chain_append(create_node((found && &big == &a) ? s_value(y) : *it), head, tail, n);
+						}
+					}
+				}
+				catch(...)
+				{
+					destroy_chain(head);
+					throw;
+				}
+				link_chain(head, n);
+				return ;
+			}
+			// otherwise copy one side and fold the other in: the larger one
+			// for a symmetric difference, else a, whose elements are kept;
+			const rbtree&	base = (op == set_symmetric_difference_op) ? big : a;
+			const rbtree&	rest = (&base == &a) ? b : a;
+
+			if (base.node_count != 0) {
+				attach_root(rb_copy(base.root(), 0), base.node_count);
+				rethread();
+			}
+			set_operation(rest, op);
+		}
+
+		// looks up every key of [first, last) and writes an iterator for
+		// each to out, end() when absent. The lookups run in groups, all
+		// descending a level per round with each one's next node already
+		// prefetched, so one lookup's cache miss overlaps the others' work;
+		template <class ForwardIterator, class OutputIterator>
+		OutputIterator	find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+			return find_group<iterator>(first, last, out);
+		}
+
+		template <class ForwardIterator, class OutputIterator>
+		OutputIterator	find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+			return find_group<const_iterator>(first, last, out);
+		}
+
+		// calls f on every element in order, or on those in [lo, hi), and
+		// returns f. The walk keeps its own stack of pending ancestors, so
+		// it never climbs parent links the way ++ does;
+		template <class Function>
+		Function	for_each(Function f) {
+			return visit<reference>(0, 0, f);
+		}
+
+		template <class Function>
+		Function	for_each(Function f) const {
+			return visit<const_reference>(0, 0, f);
+		}
+
+		template <class Function>
+		Function	for_each_range(const key_type& lo, const key_type& hi, Function f) {
+			return visit<reference>(&lo, &hi, f);
+		}
+
+		template <class Function>
+		Function	for_each_range(const key_type& lo, const key_type& hi, Function f) const {
+			return visit<const_reference>(&lo, &hi, f);
+		}
+
 		iterator		find(const key_type& k) {
-			link_type	y = header;
+			return iterator(find_node(k));
+		}
+
+		const_iterator	find(const key_type& k) const {
+			return const_iterator(find_node(k));
+		}
+
+		size_type		count(const key_type& k) const {
+			ft::pair<const_iterator, const_iterator>	p = equal_range(k);
+			size_type	n = distance(p.first, p.second);
+			return n;
+		}
+
+		// heterogeneous lookup, for a Compare tagged is_transparent: the
+		// probe is compared as is instead of being converted to key_type;
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, iterator>::type
+		find(const K& k) {
+			return iterator(find_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+		find(const K& k) const {
+			return const_iterator(find_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, size_type>::type
+		count(const K& k) const {
+			return distance(const_iterator(lower_bound_node(k)), const_iterator(upper_bound_node(k)));
+		}
+
+		// order statistics: O(log n) when Augment counts nodes, a linear
+		// walk otherwise. nth(size()) and up is end();
+		iterator		nth(size_type k) {
+			return iterator(nth_node(k));
+		}
+
+		const_iterator	nth(size_type k) const {
+			return const_iterator(nth_node(k));
+		}
+
+		// number of elements whose key is less than k;
+		size_type		rank(const key_type& k) const {
+			if (!Augment::counts_nodes) {
+				return ft::distance(begin(), lower_bound(k));
+			}
 			link_type	x = root();
+			size_type	r = 0;
 
 			while (x != 0) {
-				if (!key_compare(s_key(x), k)) {
-					y = x;
-					x = s_left(x);
-				} else {
+				if (key_compare(s_key(x), k)) {
+					r += s_size(s_left(x)) + 1;
 					x = s_right(x);
+				} else {
+					x = s_left(x);
 				}
 			}
-			iterator	j = iterator(y);
-			if (j == end() || key_compare(k, s_key(j.node))) {
-				return end();
-			} else {
-				return j;
+			return r;
+		}
+
+		difference_type	distance(const_iterator first, const_iterator last) const {
+			if (!Augment::counts_nodes) {
+				return ft::distance(first, last);
 			}
+			return difference_type(index_of(last.node)) - difference_type(index_of(first.node));
 		}
 
-		const_iterator	find(const key_type& k) const {
-			link_type	y = header;
-			link_type	x = root();
+		// refolds the augment above position once its value changed in a
+		// way the ordering does not see, O(log n);
+		void	refresh(iterator position) {
+			augment_path(position.node);
+		}
+
+		// Augment's monoid folded over the keys in [lo, hi): descend to the
+		// first node inside the range, then take the part of its left
+		// subtree at or above lo and the part of its right subtree below
+		// hi, whole subtrees at a time;
+		typename Augment::result_type	aggregate(const key_type& lo, const key_type& hi) const {
+			typedef typename Augment::result_type	result_type;
 
+			if (!Augment::augmented) {
+				result_type		r = Augment::identity();
+				const_iterator	it = lower_bound(lo);
+				for (; it != end() && key_compare(s_key(it.node), hi); ++it) {
+					r = Augment::combine(r, Augment::lift(*it));
+				}
+				return r;
+			}
+			link_type	x = root();
 			while (x != 0) {
-				if (!key_compare(s_key(x), k)) {
-					y = x;
+				if (key_compare(s_key(x), lo)) {
+					x = s_right(x);
+				} else if (!key_compare(s_key(x), hi)) {
 					x = s_left(x);
 				} else {
-					x = s_right(x);
+					break;
 				}
 			}
-			const_iterator	j = const_iterator(y);
-			if (j == end() || key_compare(k, s_key(j.node))) {
-				return end();
+			if (x == 0) {
+				return Augment::identity();
+			}
+			// pieces of the left side are found right to left, those of the
+			// right side left to right;
+			result_type	tail = Augment::lift(s_value(x));
+			for (link_type y = s_left(x); y != 0; ) {
+				if (key_compare(s_key(y), lo)) {
+					y = s_right(y);
+				} else {
+					tail = Augment::combine(Augment::combine(Augment::lift(s_value(y)), s_total(s_right(y))), tail);
+					y = s_left(y);
+				}
+			}
+			result_type	head = tail;
+			for (link_type y = s_right(x); y != 0; ) {
+				if (key_compare(s_key(y), hi)) {
+					head = Augment::combine(head, Augment::combine(s_total(s_left(y)), Augment::lift(s_value(y))));
+					y = s_right(y);
+				} else {
+					y = s_left(y);
+				}
+			}
+			return head;
+		}
+
+		iterator		lower_bound(const key_type& k) {
+			return iterator(lower_bound_node(k));
+		}
+
+		const_iterator	lower_bound(const key_type& k) const {
+			return const_iterator(lower_bound_node(k));
+		}
+
+		iterator		upper_bound(const key_type& k) {
+			return iterator(upper_bound_node(k));
+		}
+
+		const_iterator	upper_bound(const key_type& k) const {
+			return const_iterator(upper_bound_node(k));
+		}
+
+		ft::pair<iterator, iterator>	equal_range(const key_type& k) {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, iterator>::type
+		lower_bound(const K& k) {
+			return iterator(lower_bound_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+		lower_bound(const K& k) const {
+			return const_iterator(lower_bound_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, iterator>::type
+		upper_bound(const K& k) {
+			return iterator(upper_bound_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+		upper_bound(const K& k) const {
+			return const_iterator(upper_bound_node(k));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, ft::pair<iterator, iterator> >::type
+		equal_range(const K& k) {
+			return ft::pair<iterator, iterator>(iterator(lower_bound_node(k)), iterator(upper_bound_node(k)));
+		}
+
+		template <class K>
+		typename ft::enable_if_transparent<Compare, K, ft::pair<const_iterator, const_iterator> >::type
+		equal_range(const K& k) const {
+			return ft::pair<const_iterator, const_iterator>(const_iterator(lower_bound_node(k)), \
+			const_iterator(upper_bound_node(k)));
+		}
+
+
+	private:
+		template <class Iterator, class ForwardIterator, class OutputIterator>
+		OutputIterator	find_group(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+			const size_type	group = 16;
+			ForwardIterator	keys[group];
+			link_type		x[group];
+			link_type		y[group];
+
+			while (first != last) {
+				size_type	n = 0;
+				for (; n < group && first != last; ++first, ++n) {
+					keys[n] = first;
+					x[n] = root();
+					y[n] = header;
+				}
+				for (size_type live = (root() != 0) ? n : 0; live != 0; ) {
+					for (size_type i = 0; i < n; ++i) {
+						if (x[i] == 0) {
+							continue ;
+						}
+						if (!key_compare(s_key(x[i]), *keys[i])) {
+							y[i] = x[i];
+							x[i] = s_left(x[i]);
+						} else {
+							x[i] = s_right(x[i]);
+						}
+						if (x[i] == 0) {
+							--live;
+						} else {
+							s_prefetch(x[i]);
+						}
+					}
+				}
+				for (size_type i = 0; i < n; ++i) {
+					if (y[i] != header && key_compare(*keys[i], s_key(y[i]))) {
+						y[i] = header;
+					}
+					*out = Iterator(y[i]);
+					++out;
+				}
+			}
+			return out;
+		}
+
+		// in-order walk below lo and hi, either of which may be 0 for no
+		// bound. A red-black tree is at most twice as deep as log2(n + 1),
+		// which bounds the stack; the right subtree, visited next, is
+		// prefetched while f runs;
+		template <class Ref, class Function>
+		Function	visit(const key_type* lo, const key_type* hi, Function f) const {
+			link_type	stack[2 * std::numeric_limits<size_type>::digits];
+			size_type	top = 0;
+			link_type	x = root();
+
+			for (;;) {
+				while (x != 0) {
+					if (lo != 0 && key_compare(s_key(x), *lo)) {
+						x = s_right(x);
+					} else {
+						stack[top++] = x;
+						x = s_left(x);
+					}
+				}
+				if (top == 0) {
+					break ;
+				}
+				x = stack[--top];
+				if (hi != 0 && !key_compare(s_key(x), *hi)) {
+					break ;
+				}
+				// everything left from here is above lo;
+				lo = 0;
+				s_prefetch(s_right(x));
+				f(static_cast<Ref>(s_value(x)));
+				x = s_right(x);
+			}
+			return f;
+		}
+
+		// a free standing tree and its black height, handed along by split
+		// and join so that neither walks a spine to find it;
+		struct free_tree
+		{
+			link_type	root;
+			size_type	height;
+
+			free_tree(link_type x = 0, size_type h = 0)
+			: root(x), height(h) {}
+		};
+
+		// the root as a free standing tree: no parent, and black, which
+		// an rb tree root may always be made;
+		link_type	detach_root() {
+			link_type	x = root();
+
+			if (x != 0) {
+				x->set_parent(0);
+				x->set_color(black);
+			}
+			set_root(0);
+			return x;
+		}
+
+		free_tree	detach_tree() {
+			link_type	x = detach_root();
+			return free_tree(x, black_height(x));
+		}
+
+		void		attach_root(link_type x, size_type n) {
+			set_root(x);
+			if (x == 0) {
+				leftmost() = header;
+				rightmost() = header;
 			} else {
-				return j;
+				x->set_parent(header);
+				leftmost() = s_minimum(x);
+				rightmost() = s_maximum(x);
 			}
+			node_count = n;
+			thread_ends();
 		}
 
-		size_type		count(const key_type& k) const {
-			ft::pair<const_iterator, const_iterator>	p = equal_range(k);
-			size_type	n = ft::distance(p.first, p.second);
-			return n;
+		// black nodes on any path down from x, x included;
+		static size_type	black_height(link_type x) {
+			size_type	h = 0;
+
+			for (; x != 0; x = s_left(x)) {
+				if (x->color() == black) {
+					++h;
+				}
+			}
+			return h;
+		}
+
+		// l < k < r, l and r free standing trees with black roots: hang k,
+		// red, where the spine of the taller tree reaches the black height
+		// of the other one, then repair as after an insertion. Costs the
+		// difference in black heights, plus the climb of the repair;
+		free_tree	join_trees(free_tree lt, link_type k, free_tree rt) {
+			link_type	l = lt.root;
+			link_type	r = rt.root;
+			size_type	lh = lt.height;
+			size_type	rh = rt.height;
+
+			s_left(k) = l;
+			s_right(k) = r;
+			if (l != 0) {
+				l->set_parent(k);
+			}
+			if (r != 0) {
+				r->set_parent(k);
+			}
+			if (lh == rh) {
+				k->set_parent(0);
+				k->set_color(black);
+				s_update(k);
+				return free_tree(k, lh + 1);
+			}
+			link_type	top = (lh > rh) ? l : r;
+			link_type	c = top;
+			link_type	p = 0;
+			size_type	h = (lh > rh) ? lh : rh;
+			size_type	target = (lh > rh) ? rh : lh;
+
+			while (c != 0 && (c->color() == red || h != target)) {
+				if (c->color() == black) {
+					--h;
+				}
+				p = c;
+				c = (lh > rh) ? s_right(c) : s_left(c);
+			}
+			if (lh > rh) {
+				s_left(k) = c;
+				s_right(p) = k;
+			} else {
+				s_right(k) = c;
+				s_left(p) = k;
+			}
+			if (c != 0) {
+				c->set_parent(k);
+			}
+			k->set_parent(p);
+			top->set_parent(0);
+			augment_path(k);
+			h = (lh > rh) ? lh : rh;
+			if (rb_tree_rebalance(k, top)) {
+				++h;
+			}
+			return free_tree(top, h);
 		}
 
-		iterator		lower_bound(const key_type& k) {
+		// makes the subtree at x free standing;
+		static link_type	s_detach(link_type x) {
+			if (x != 0) {
+				x->set_parent(0);
+				x->set_color(black);
+			}
+			return x;
+		}
+
+		// makes the child x of a free standing root of black height h free
+		// standing; a red child gains a level when it is blackened;
+		static free_tree	s_subtree(link_type x, size_type h) {
+			size_type	xh = (x != 0 && x->color() == red) ? h : h - 1;
+			return free_tree(s_detach(x), xh);
+		}
+
+		// splits the free standing tree x into l (keys below k), m (the
+		// node holding k, or 0) and r (keys above k). The joins on the way
+		// up cost the height differences, which add up to O(log n);
+		void		split_tree(free_tree x, const key_type& k, free_tree& l, link_type& m, free_tree& r) {
+			if (x.root == 0) {
+				l = free_tree();
+				m = 0;
+				r = free_tree();
+				return ;
+			}
+			free_tree	xl = s_subtree(s_left(x.root), x.height);
+			free_tree	xr = s_subtree(s_right(x.root), x.height);
+
+			if (key_compare(s_key(x.root), k)) {
+				free_tree	rl;
+				split_tree(xr, k, rl, m, r);
+				l = join_trees(xl, x.root, rl);
+			} else if (key_compare(k, s_key(x.root))) {
+				free_tree	lr;
+				split_tree(xl, k, l, m, lr);
+				r = join_trees(lr, x.root, xr);
+			} else {
+				l = xl;
+				m = x.root;
+				r = xr;
+			}
+		}
+
+		// l < r, both free standing: the maximum of l is unlinked from the
+		// end of its right spine to serve as the joining node;
+		free_tree	join_pair(free_tree l, free_tree r) {
+			if (l.root == 0) {
+				return r;
+			}
+			if (r.root == 0) {
+				return l;
+			}
+			link_type	k = s_maximum(l.root);
+			link_type	none = 0;
+			bool		shrank = false;
+
+			rb_tree_rebalance_for_erase(k, l.root, none, none, &shrank);
+			if (shrank) {
+				--l.height;
+			}
+			return join_trees(l, k, r);
+		}
+
+		// split/join forms of the set operations on free standing trees:
+		// t1 is split at the keys of t2 and the pieces joined back. t2 is
+		// consumed by union and symmetric difference and only read by the
+		// others; common counts the keys found in both;
+		free_tree	union_trees(free_tree t1, free_tree t2, size_type& common) {
+			if (t1.root == 0) {
+				return t2;
+			}
+			if (t2.root == 0) {
+				return t1;
+			}
+			free_tree	l2 = s_subtree(s_left(t2.root), t2.height);
+			free_tree	r2 = s_subtree(s_right(t2.root), t2.height);
+			free_tree	l1;
+			link_type	m;
+			free_tree	r1;
+
+			split_tree(t1, s_key(t2.root), l1, m, r1);
+			free_tree	l = union_trees(l1, l2, common);
+			free_tree	r = union_trees(r1, r2, common);
+			if (m != 0) {
+				// equivalent keys: ours stays, the copy goes;
+				destroy_node(t2.root);
+				++common;
+				return join_trees(l, m, r);
+			}
+			return join_trees(l, t2.root, r);
+		}
+
+		free_tree	intersect_trees(free_tree t1, link_type t2, size_type& common) {
+			if (t1.root == 0) {
+				return free_tree();
+			}
+			if (t2 == 0) {
+				rb_erase(t1.root);
+				return free_tree();
+			}
+			free_tree	l1;
+			link_type	m;
+			free_tree	r1;
+
+			split_tree(t1, s_key(t2), l1, m, r1);
+			free_tree	l = intersect_trees(l1, s_left(t2), common);
+			free_tree	r = intersect_trees(r1, s_right(t2), common);
+			if (m != 0) {
+				++common;
+				return join_trees(l, m, r);
+			}
+			return join_pair(l, r);
+		}
+
+		free_tree	subtract_trees(free_tree t1, link_type t2, size_type& common) {
+			if (t1.root == 0 || t2 == 0) {
+				return t1;
+			}
+			free_tree	l1;
+			link_type	m;
+			free_tree	r1;
+
+			split_tree(t1, s_key(t2), l1, m, r1);
+			if (m != 0) {
+				destroy_node(m);
+				++common;
+			}
+			free_tree	l = subtract_trees(l1, s_left(t2), common);
+			free_tree	r = subtract_trees(r1, s_right(t2), common);
+			return join_pair(l, r);
+		}
+
+		free_tree	symmetric_trees(free_tree t1, free_tree t2, size_type& common) {
+			if (t1.root == 0) {
+				return t2;
+			}
+			if (t2.root == 0) {
+				return t1;
+			}
+			free_tree	l2 = s_subtree(s_left(t2.root), t2.height);
+			free_tree	r2 = s_subtree(s_right(t2.root), t2.height);
+			free_tree	l1;
+			link_type	m;
+			free_tree	r1;
+
+			split_tree(t1, s_key(t2.root), l1, m, r1);
+			free_tree	l = symmetric_trees(l1, l2, common);
+			free_tree	r = symmetric_trees(r1, r2, common);
+			if (m != 0) {
+				destroy_node(m);
+				destroy_node(t2.root);
+				++common;
+				return join_pair(l, r);
+			}
+			return join_trees(l, t2.root, r);
+		}
+
+		// a split/join pass costs about small * log(big / small) steps,
+		// each a few times a merge step;
+		static bool	prefer_split_join(size_type n, size_type m) {
+			size_type	small = (n < m) ? n : m;
+			size_type	big = (n < m) ? m : n;
+			size_type	log = 1;
+
+			if (small == 0) {
+				return true;
+			}
+			for (size_type q = big / small; q > 1; q >>= 1) {
+				++log;
+			}
+			return small * log * 4 < big;
+		}
+
+		void		split_join_operation(const rbtree& other, rb_tree_set_operation op) {
+			free_tree	t2;
+
+			if (other.node_count != 0 && (op == set_union_op || op == set_symmetric_difference_op)) {
+				link_type	x = rb_copy(other.root(), 0);
+				t2 = free_tree(x, black_height(x));
+			}
+			size_type	n = node_count;
+			size_type	m = other.node_count;
+			size_type	common = 0;
+			free_tree	t1 = detach_tree();
+
+			switch (op) {
+			case set_union_op:
+				t1 = union_trees(t1, t2, common);
+				n = n + m - common;
+				break ;
+			case set_intersection_op:
+				t1 = intersect_trees(t1, other.root(), common);
+				n = common;
+				break ;
+			case set_difference_op:
+				t1 = subtract_trees(t1, other.root(), common);
+				n = n - common;
+				break ;
+			case set_symmetric_difference_op:
+				t1 = symmetric_trees(t1, t2, common);
+				n = n + m - 2 * common;
+				break ;
+			}
+			attach_root(s_detach(t1.root), n);
+		}
+
+		// whether op keeps a key found in a, b or both;
+		static bool	s_keeps(rb_tree_set_operation op, bool in_a, bool in_b) {
+			switch (op) {
+			case set_intersection_op:
+				return in_a && in_b;
+			case set_difference_op:
+				return in_a && !in_b;
+			case set_symmetric_difference_op:
+				return in_a != in_b;
+			default:
+				return true;
+			}
+		}
+
+		// walks our nodes, chained in order, against other and rechains the
+		// ones op keeps along with copies of other's. The copies are all
+		// made up front, so a throwing copy leaves the tree as it was;
+		void		merge_operation(const rbtree& other, rb_tree_set_operation op) {
+			link_type		copies = copy_added(other, op);
+			link_type		x = flatten();
+			const_iterator	j = other.begin();
+			link_type		head = 0;
+			link_type		tail = 0;
+			size_type		n = 0;
+
+			while (x != 0 || j != other.end()) {
+				bool	in_a = (x != 0);
+				bool	in_b = (j != other.end());
+				if (in_a && in_b) {
+					in_a = !key_compare(KeyOfVal()(*j), s_key(x));
+					in_b = !key_compare(s_key(x), KeyOfVal()(*j));
+				}
+				bool	keep = s_keeps(op, in_a, in_b);
+				if (in_a) {
+					link_type	next = s_right(x);
+					if (keep) {
+						chain_append(x, head, tail, n);
+					} else {
+						destroy_node(x);
+					}
+					x = next;
+				} else if (keep) {
+					link_type	next = s_right(copies);
+					chain_append(copies, head, tail, n);
+					copies = next;
+				}
+				if (in_b) {
+					++j;
+				}
+			}
+			link_chain(head, n);
+		}
+
+		// copies, chained in order, of the elements of other that are not
+		// here and that op adds; the tree itself is only read;
+		link_type	copy_added(const rbtree& other, rb_tree_set_operation op) {
+			link_type		head = 0;
+			link_type		tail = 0;
+			size_type		n = 0;
+
+			if (!s_keeps(op, false, true)) {
+				return 0;
+			}
+			const_iterator	i = begin();
+			const_iterator	j = other.begin();
+
+			try
+			{
+				while (j != other.end()) {
+					if (i != end() && key_compare(KeyOfVal()(*i), KeyOfVal()(*j))) {
+						++i;
+						continue ;
+					}
+					if (i == end() || key_compare(KeyOfVal()(*j), KeyOfVal()(*i))) {
+						chain_append(create_node(*j), head, tail, n);
+					} else {
+						++i;
+					}
+					++j;
+				}
+			}
+			catch(...)
+			{
+				destroy_chain(head);
+				throw;
+			}
+			return head;
+		}
+
+		void		merge_ranges(const rbtree& a, const rbtree& b, rb_tree_set_operation op) {
+			const_iterator	i = a.begin();
+			const_iterator	j = b.begin();
+			link_type		head = 0;
+			link_type		tail = 0;
+			size_type		n = 0;
+
+			try
+			{
+				while (i != a.end() || j != b.end()) {
+					bool	in_a = (i != a.end());
+					bool	in_b = (j != b.end());
+					if (in_a && in_b) {
+						in_a = !key_compare(KeyOfVal()(*j), KeyOfVal()(*i));
+						in_b = !key_compare(KeyOfVal()(*i), KeyOfVal()(*j));
+					}
+					if (s_keeps(op, in_a, in_b)) {
+						chain_append(create_node(in_a ? *i : *j), head, tail, n);
+					}
+					if (in_a) {
+						++i;
+					}
+					if (in_b) {
+						++j;
+					}
+				}
+			}
+			catch(...)
+			{
+				destroy_chain(head);
+				throw;
+			}
+			link_chain(head, n);
+		}
+
+		// unhooks every node into a chain through the right links, in order,
+		// leaving the tree empty. Walks back from the maximum: stepping back
+		// only reads the right links of smaller nodes, not yet rechained;
+		link_type	flatten() {
+			link_type	head = 0;
+			link_type	x = rightmost();
+
+			for (size_type i = node_count; i != 0; --i) {
+				iterator	prev(x);
+				--prev;
+				s_right(x) = head;
+				head = x;
+				x = prev.node;
+			}
+			attach_root(0, 0);
+			return head;
+		}
+
+		static void	chain_append(link_type z, link_type& head, link_type& tail, size_type& n) {
+			s_right(z) = 0;
+			if (tail != 0) {
+				s_right(tail) = z;
+			} else {
+				head = z;
+			}
+			tail = z;
+			++n;
+		}
+
+		void		destroy_chain(link_type head) {
+			while (head != 0) {
+				link_type	next = s_right(head);
+				destroy_node(head);
+				head = next;
+			}
+		}
+
+		// hangs n chained nodes, in order, as a balanced tree;
+		void		link_chain(link_type head, size_type n) {
+			if (n == 0) {
+				attach_root(0, 0);
+				return ;
+			}
+			size_type	depth = 0;
+			for (size_type m = n; m > 1; m >>= 1) {
+				++depth;
+			}
+			// only a partly filled bottom level is red, which keeps the
+			// black height equal on every path;
+			size_type	red_depth = (n == (size_type(2) << depth) - 1) ? n : depth;
+
+			if (thread_traits::threaded) {
+				for (link_type x = head; s_right(x) != 0; x = s_right(x)) {
+					s_thread(x, s_right(x));
+				}
+			}
+			attach_root(build_balanced(head, n, 0, red_depth, 0), n);
+		}
+
+		// size of r out of n, walking both halves in step so that only the
+		// smaller one is counted;
+		static size_type	count_upper(link_type l, link_type r, size_type n) {
+			link_type	x = (l != 0) ? s_minimum(l) : 0;
+			link_type	y = (r != 0) ? s_minimum(r) : 0;
+			size_type	i = 0;
+
+			for (;;) {
+				if (y == 0) {
+					return i;
+				}
+				if (x == 0) {
+					return n - i;
+				}
+				x = s_next(x);
+				y = s_next(y);
+				++i;
+			}
+		}
+
+		// in-order successor inside a free standing tree, 0 past the end;
+		static link_type	s_next(link_type x) {
+			if (s_right(x) != 0) {
+				return s_minimum(s_right(x));
+			}
+			link_type	p = s_parent(x);
+			while (p != 0 && x == s_right(p)) {
+				x = p;
+				p = s_parent(p);
+			}
+			return p;
+		}
+
+		// takes x out of the tree without destroying it;
+		link_type	unlink_node(link_type x) {
+			s_thread(thread_traits::prev(x), thread_traits::next(x));
+			link_type	new_root = root();
+			link_type	y = \
+			(link_type)rb_tree_rebalance_for_erase(x, \
+			new_root, header->left, header->right);
+			set_root(new_root);
+			--node_count;
+			return y;
+		}
+
+		// the node of nh, or a copy of its element when it comes from an
+		// allocator that cannot free it here (nh's node is then released);
+		link_type	adopt_node(const node_handle& nh) {
+			if (nh.node_alloc == node_allocator) {
+				return nh.release();
+			}
+#if __cplusplus >= 201103L
+			link_type	z = create_node(std::move(nh.node->value_field));
+#else
+			link_type	z = create_node(nh.node->value_field);
+#endif
+			node_handle(nh.release(), nh.node_alloc, nh.data_alloc);
+			return z;
+		}
+
+		// the descents behind every lookup; K is key_type unless Compare is
+		// transparent;
+		template <class K>
+		link_type	lower_bound_node(const K& k) const {
 			link_type	y = header;
 			link_type 	x = root();
 
 			while (x != 0) {
+				s_prefetch_children(x);
 				if (!(key_compare(s_key(x), k))) {
 					y = x;
 					x = s_left(x);
@@ -563,114 +2195,258 @@ namespace ft
 					x = s_right(x);
 				}
 			}
-			return iterator(y);
+			return y;
 		}
 
-		const_iterator	lower_bound(const key_type& k) const {
+		template <class K>
+		link_type	upper_bound_node(const K& k) const {
 			link_type	y = header;
 			link_type 	x = root();
 
 			while (x != 0) {
-				if (!(key_compare(s_key(x), k))) {
+				s_prefetch_children(x);
+				if (key_compare(k, s_key(x))) {
 					y = x;
 					x = s_left(x);
 				} else {
 					x = s_right(x);
 				}
 			}
-			return const_iterator(y);
+			return y;
 		}
 
-		iterator		upper_bound(const key_type& k) {
-			link_type	y = header;
-			link_type 	x = root();
+		template <class K>
+		link_type	find_node(const K& k) const {
+			link_type	j = lower_bound_node(k);
 
-			while (x != 0) {
-				if (key_compare(k, s_key(x))) {
-					y = x;
+			if (j == header || key_compare(k, s_key(j))) {
+				return header;
+			}
+			return j;
+		}
+
+		link_type	nth_node(size_type k) const {
+			if (k >= node_count) {
+				return header;
+			}
+			if (!Augment::counts_nodes) {
+				const_iterator	it = begin();
+				while (k-- != 0) {
+					++it;
+				}
+				return it.node;
+			}
+			link_type	x = root();
+			for (;;) {
+				size_type	left_n = s_size(s_left(x));
+				if (k < left_n) {
 					x = s_left(x);
+				} else if (k == left_n) {
+					return x;
 				} else {
+					k -= left_n + 1;
 					x = s_right(x);
 				}
 			}
-			return iterator(y);
+		}
+
+		// in-order position of x, found by climbing to the root;
+		size_type	index_of(link_type x) const {
+			if (x == header) {
+				return node_count;
+			}
+			size_type	i = s_size(s_left(x));
+			link_type	top = root();
 
+			while (x != top) {
+				link_type	p = s_parent(x);
+				if (x == s_right(p)) {
+					i += s_size(s_left(p)) + 1;
+				}
+				x = p;
+			}
+			return i;
 		}
-		const_iterator	upper_bound(const key_type& k) const {
-			link_type	y = header;
-			link_type 	x = root();
 
+		// (x, y) such that a node for k belongs under parent y, on the left
+		// when x is non-null; (existing node, 0) if k is already present;
+		ft::pair<link_type, link_type>	get_insert_unique_pos(const key_type& k) {
+			link_type	y = header;
+			link_type	x = root();
+			bool		comp = true;
 			while (x != 0) {
-				if (key_compare(k, s_key(x))) {
-					y = x;
+				y = x;
+				comp = key_compare(k, s_key(x));
+				if (comp) {
 					x = s_left(x);
 				} else {
 					x = s_right(x);
 				}
 			}
-			return const_iterator(y);
+			iterator	j = iterator(y);
+			if (comp) {
+				if (j == begin()) {
+					return ft::pair<link_type, link_type>(x, y);
+				} else {
+					--j;
+				}
+			}
+			if (key_compare(s_key(j.node), k)) {
+				return ft::pair<link_type, link_type>(x, y);
+			}
+			return ft::pair<link_type, link_type>(j.node, link_type(0));
 		}
 
-		ft::pair<iterator, iterator>	equal_range(const key_type& k) {
-			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		ft::pair<link_type, link_type>	get_insert_hint_unique_pos(iterator position, const key_type& k) {
+			if (position.node == header->left) {
+				if (size() > 0 && key_compare(k, s_key(position.node))) {
+					return ft::pair<link_type, link_type>(position.node, position.node);
+				}
+			} else if (position.node == header) {
+				if (key_compare(s_key(rightmost()), k)) {
+					return ft::pair<link_type, link_type>(link_type(0), rightmost());
+				}
+			} else {
+				iterator	before = position;
+				--before;
+				if (key_compare(s_key(before.node), k) && key_compare(k, s_key(position.node))) {
+					if (s_right(before.node) == 0) {
+						return ft::pair<link_type, link_type>(link_type(0), before.node);
+					} else {
+						return ft::pair<link_type, link_type>(position.node, position.node);
+					}
+				}
+			}
+			return get_insert_unique_pos(k);
 		}
 
-		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
-			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		// chains nodes for the ascending prefix of [first, last) through their
+		// right links, then hangs them as a balanced tree; returns the first
+		// element that was not taken;
+		template<class InputIterator>
+		InputIterator	build_from_sorted(InputIterator first, InputIterator last) {
+			link_type	head = 0;
+			link_type	tail = 0;
+			size_type	n = 0;
+
+			try
+			{
+				for (; first != last; ++first) {
+					if (tail != 0 && !key_compare(s_key(tail), KeyOfVal()(*first))) {
+						break;
+					}
+					chain_append(create_node(*first), head, tail, n);
+				}
+			}
+			catch(...)
+			{
+				destroy_chain(head);
+				throw;
+			}
+			if (n != 0) {
+				link_chain(head, n);
+			}
+			return first;
 		}
 
+		// consumes n nodes from the list at head, in order;
+		link_type	build_balanced(link_type& head, size_type n, size_type depth, size_type red_depth, link_type parent) {
+			if (n == 0) {
+				return 0;
+			}
+			size_type	left_n = (n - 1) / 2;
+			link_type	left = build_balanced(head, left_n, depth + 1, red_depth, 0);
+			link_type	x = head;
+
+			head = s_right(head);
+			s_left(x) = left;
+			if (left != 0) {
+				left->set_parent(x);
+			}
+			x->set_parent(parent);
+			x->set_color((depth == red_depth) ? red : black);
+			s_right(x) = build_balanced(head, n - 1 - left_n, depth + 1, red_depth, x);
+			s_update(x);
+			return x;
+		}
 
-	private:
 		iterator	rb_insert(link_type x_ptr, link_type y_ptr, const value_type& to_insert) {
+			return link_node(x_ptr, y_ptr, create_node(to_insert));
+		}
+
+		// hang the already constructed node z at the slot found by
+		// get_insert_unique_pos(), then rebalance;
+		iterator	link_node(link_type x_ptr, link_type y_ptr, link_type z) {
 			link_type	x = x_ptr;
 			link_type	y = y_ptr;
-			link_type	z;
+			bool		insert_left;
 
-			if (y == header || x != 0 || key_compare(KeyOfVal()(to_insert), s_key(y))) {
-				z = create_node(to_insert);
+			try
+			{
+				insert_left = (y == header || x != 0 || key_compare(s_key(z), s_key(y)));
+			}
+			catch(...)
+			{
+				destroy_node(z);
+				throw;
+			}
+			if (insert_left) {
 				s_left(y) = z;
 				if (y == header) {
-					root() = z;
+					set_root(z);
 					rightmost() = z;
 				} else if (y == leftmost()) {
 					leftmost() = z;
 				}
+				s_thread(thread_traits::prev(y), z);
+				s_thread(z, y);
 			} else {
-				z = create_node(to_insert);
 				s_right(y) = z;
 				if (y == rightmost()) {
 					rightmost() = z;
 				}
+				s_thread(z, thread_traits::next(y));
+				s_thread(y, z);
 			}
-			s_parent(z) = y;
+			z->set_parent(y);
 			s_left(z) = 0;
 			s_right(z) = 0;
-			rb_tree_rebalance(z, header->parent);
+			augment_path(z);
+			link_type	new_root = root();
+			rb_tree_rebalance(z, new_root);
+			set_root(new_root);
 			++node_count;
 			return iterator(z);
 		}
 
+		// copies the subtree at x under p. No recursion: the source is
+		// walked through its parent links and the copy through its own,
+		// each node's children copied left first;
 		link_type	rb_copy(link_type x, link_type p) {
 			link_type	top = clone_node(x);
-			top->parent = p;
+			link_type	src = x;
+			link_type	dst = top;
 
+			top->set_parent(p);
 			try
 			{
-				if (x->right) {
-					top->right = rb_copy(s_right(x), top);
-				}
-				p = top;
-				x = s_left(x);
-				while (x != 0)
-				{
-					link_type	y = clone_node(x);
-					p->left = y;
-					y->parent = p;
-					if (x->right) {
-						y->right = rb_copy(s_right(x), y);
+				for (;;) {
+					if (s_left(src) != 0 && s_left(dst) == 0) {
+						src = s_left(src);
+						s_left(dst) = clone_node(src);
+						s_left(dst)->set_parent(dst);
+						dst = s_left(dst);
+					} else if (s_right(src) != 0 && s_right(dst) == 0) {
+						src = s_right(src);
+						s_right(dst) = clone_node(src);
+						s_right(dst)->set_parent(dst);
+						dst = s_right(dst);
+					} else if (src == x) {
+						break ;
+					} else {
+						src = s_parent(src);
+						dst = s_parent(dst);
 					}
-					p = y;
-					x = s_left(x);
 				}
 			}
 			catch(...)
@@ -681,13 +2457,26 @@ namespace ft
 			return top;
 		}
 
-		void		rb_erase(link_type x) {
+		// destroys the subtree at x, returning how many nodes it held. No
+		// recursion: a left child is rotated up until the top has none,
+		// then the top goes and its right child takes over;
+		size_type	rb_erase(link_type x) {
+			size_type	n = 0;
+
 			while (x != 0) {
-				rb_erase(s_right(x));
 				link_type	y = s_left(x);
-				destroy_node(x);
-				x = y;
+				if (y != 0) {
+					s_left(x) = s_right(y);
+					s_right(y) = x;
+					x = y;
+				} else {
+					y = s_right(x);
+					destroy_node(x);
+					x = y;
+					++n;
+				}
 			}
+			return n;
 		}
 
 		void	rb_tree_rotate_left(link_type x, link_type& root) {
@@ -695,18 +2484,20 @@ namespace ft
 
 			x->right = y->left;
 			if (y->left != 0) {
-				y->left->parent = x;
+				y->left->set_parent(x);
 			}
-			y->parent = x->parent;
+			y->set_parent(x->parent());
 			if (x == root) {
 				root = y;
-			} else if (x == x->parent->left) {
-				x->parent->left = y;
+			} else if (x == x->parent()->left) {
+				x->parent()->left = y;
 			} else {
-				x->parent->right = y;
+				x->parent()->right = y;
 			}
 			y->left = x;
-			x->parent = y;
+			x->set_parent(y);
+			s_update(x);
+			s_update(y);
 		}
 
 		void	rb_tree_rotate_right(link_type x, link_type& root) {
@@ -714,71 +2505,77 @@ namespace ft
 
 			x->left = y->right;
 			if (y->right != 0) {
-				y->right->parent = x;
+				y->right->set_parent(x);
 			}
-			y->parent = x->parent;
+			y->set_parent(x->parent());
 			if (x == root) {
 				root = y;
-			} else if (x == x->parent->right) {
-				x->parent->right = y;
+			} else if (x == x->parent()->right) {
+				x->parent()->right = y;
 			} else {
-				x->parent->left = y;
+				x->parent()->left = y;
 			}
 			y->right = x;
-			x->parent = y;
+			x->set_parent(y);
+			s_update(x);
+			s_update(y);
 		}
 
 		link_type	recoloring(link_type x, link_type uncle) {
-				x->parent->color = black;
-				uncle->color = black;
-				x->parent->parent->color = red;
-				x = x->parent->parent;
+				x->parent()->set_color(black);
+				uncle->set_color(black);
+				x->parent()->parent()->set_color(red);
+				x = x->parent()->parent();
 				return x;
 			}
 
 		link_type	reconstructing(link_type x, link_type& root, \
 									rb_tree_direction x_parent_dir) {
 				if (x_parent_dir == left) {
-					if (x == x->parent->right) {
-						x = x->parent;
+					if (x == x->parent()->right) {
+						x = x->parent();
 						rb_tree_rotate_left(x, root);
 					}
-					x->parent->color = black;
-					x->parent->parent->color = red;
-					rb_tree_rotate_right(x->parent->parent, root);
+					x->parent()->set_color(black);
+					x->parent()->parent()->set_color(red);
+					rb_tree_rotate_right(x->parent()->parent(), root);
 				} else {
-					if (x == x->parent->left) {
-						x = x->parent;
+					if (x == x->parent()->left) {
+						x = x->parent();
 						rb_tree_rotate_right(x, root);
 					}
-					x->parent->color = black;
-					x->parent->parent->color = red;
-					rb_tree_rotate_left(x->parent->parent, root);
+					x->parent()->set_color(black);
+					x->parent()->parent()->set_color(red);
+					rb_tree_rotate_left(x->parent()->parent(), root);
 				}
 				return x;
 			}
 
-		void	rb_tree_rebalance(link_type x, link_type& root) {
-			x->color = red;
-			while (x != root && x->parent->color == red)
+		// true when the root had to be blackened, which adds a black level
+		// to every path;
+		bool	rb_tree_rebalance(link_type x, link_type& root) {
+			x->set_color(red);
+			while (x != root && x->parent()->color() == red)
 			{
-				if (x->parent == x->parent->parent->left) {
-					link_type	y = x->parent->parent->right;
-					if (y && y->color == red) {
+				if (x->parent() == x->parent()->parent()->left) {
+					link_type	y = x->parent()->parent()->right;
+					if (y && y->color() == red) {
 						x = recoloring(x, y);
 					} else {
 						x = reconstructing(x, root, left);
 					}
 				} else {
-					link_type	y = x->parent->parent->left;
-					if (y && y->color == red) {
+					link_type	y = x->parent()->parent()->left;
+					if (y && y->color() == red) {
 						x = recoloring(x, y);
 					} else {
 						x = reconstructing(x, root, right);
 					}
 				}
 			}
-			root->color = black;
+			bool	grew = root->color() == red;
+			root->set_color(black);
+			return grew;
 		}
 
 		void	find_erase_target_successor(link_type& y, link_type& x) {
@@ -801,28 +2598,30 @@ namespace ft
 		link_type& z, link_type& root) {
 			link_type	x_parent = 0;
 
-			z->left->parent = y;
+			z->left->set_parent(y);
 			y->left = z->left;
 			if (y != z->right) {
-				x_parent = y->parent;
+				x_parent = y->parent();
 				if (x) {
-					x->parent = y->parent;
+					x->set_parent(y->parent());
 				}
-				y->parent->left = x;
+				y->parent()->left = x;
 				y->right = z->right;
-				z->right->parent = y;
+				z->right->set_parent(y);
 			} else {
 				x_parent = y;
 			}
 			if (root == z) {
 				root = y;
-			} else if (z->parent->left == z) {
-				z->parent->left = y;
+			} else if (z->parent()->left == z) {
+				z->parent()->left = y;
 			} else {
-				z->parent->right = y;
+				z->parent()->right = y;
 			}
-			y->parent = z->parent;
-			std::swap(y->color, z->color);
+			y->set_parent(z->parent());
+			rb_tree_color	y_color = y->color();
+			y->set_color(z->color());
+			z->set_color(y_color);
 			y = z;
 			return x_parent;
 		}
@@ -831,17 +2630,17 @@ namespace ft
 		link_type& z, link_type& root) {
 			link_type	x_parent = 0;
 
-			x_parent = y->parent;
+			x_parent = y->parent();
 			if (x) {
-				x->parent = y->parent;
+				x->set_parent(y->parent());
 			}
 			if (root == z) {
 				root = x;
 			} else {
-				if (z->parent->left == z) {
-					z->parent->left = x;
+				if (z->parent()->left == z) {
+					z->parent()->left = x;
 				} else {
-					z->parent->right = x;
+					z->parent()->right = x;
 				}
 			}
 			return x_parent;
@@ -852,25 +2651,30 @@ namespace ft
 
 			if (leftmost == z) {
 				if (z->right == 0) {
-					leftmost = z->parent;
+					leftmost = z->parent();
 				} else {
 					leftmost = rb_tree_node<Val>::minimum(x);
 				}
 			}
 			if (rightmost == z) {
 				if (z->left == 0) {
-					rightmost = z->parent;
+					rightmost = z->parent();
 				} else {
 					rightmost = rb_tree_node<Val>::maximum(x);
 				}
 			}
 		}
 
+		// shrank, when given, tells whether every path lost a black node,
+		// which a free standing tree needs to keep its height;
 		link_type	rb_tree_rebalance_for_erase(link_type z, \
-		link_type& root, link_type& leftmost, link_type& rightmost) {
+		link_type& root, link_type& leftmost, link_type& rightmost, bool* shrank = 0) {
 			link_type	y = z;
 			link_type	x = 0;
 			link_type	x_parent = 0;
+			if (shrank != 0) {
+				*shrank = false;
+			}
 			find_erase_target_successor(y, x);
 			if (y != z) {
 				x_parent = relink_target_successor(x, y, z, root);
@@ -878,72 +2682,78 @@ namespace ft
 				x_parent = relink_target_child(x, y, z, root);
 				redefine_edge_value(x, z, leftmost, rightmost);
 			}
-			if (y->color != red) {
-				while (x != root && (x == 0 || x->color == black)) {
+			// the rotations below keep the data right as long as it is
+			// right going in, so fix the spliced path first;
+			augment_path(x_parent);
+			if (y->color() != red) {
+				while (x != root && (x == 0 || x->color() == black)) {
 					if (x == x_parent->left) {
 						link_type	w = x_parent->right;
-						if (w->color == red) {
-							w->color = black;
-							x_parent->color = red;
+						if (w->color() == red) {
+							w->set_color(black);
+							x_parent->set_color(red);
 							rb_tree_rotate_left(x_parent, root);
 							w = x_parent->right;
 						}
-						if ((w->left == 0 || w->left->color == black) && \
-						(w->right == 0 || w->right->color == black)) {
-							w->color = red;
+						if ((w->left == 0 || w->left->color() == black) && \
+						(w->right == 0 || w->right->color() == black)) {
+							w->set_color(red);
 							x = x_parent;
-							x_parent = x_parent->parent;
+							x_parent = x_parent->parent();
 						} else {
-							if (w->right == 0 || w->right->color == black) {
+							if (w->right == 0 || w->right->color() == black) {
 								if (w->left) {
-									w->left->color = black;
+									w->left->set_color(black);
 								}
-								w->color = red;
+								w->set_color(red);
 								rb_tree_rotate_right(w, root);
 								w = x_parent->right;
 							}
-							w->color = x_parent->color;
-							x_parent->color = black;
+							w->set_color(x_parent->color());
+							x_parent->set_color(black);
 							if (w->right) {
-								w->right->color = black;
+								w->right->set_color(black);
 							}
 							rb_tree_rotate_left(x_parent, root);
 							break;
 						}
 					} else {
 						link_type	w = x_parent->left;
-						if (w->color == red) {
-							w->color = black;
-							x_parent->color = red;
+						if (w->color() == red) {
+							w->set_color(black);
+							x_parent->set_color(red);
 							rb_tree_rotate_right(x_parent, root);
 							w = x_parent->left;
 						}
-						if ((w->right == 0 || w->right->color == black) && \
-						(w->left == 0 || w->left->color == black)) {
-							w->color = red;
+						if ((w->right == 0 || w->right->color() == black) && \
+						(w->left == 0 || w->left->color() == black)) {
+							w->set_color(red);
 							x = x_parent;
-							x_parent = x_parent->parent;
+							x_parent = x_parent->parent();
 						} else {
-							if (w->left == 0 || w->left->color == black) {
+							if (w->left == 0 || w->left->color() == black) {
 								if (w->right) {
-									w->right->color = black;
+									w->right->set_color(black);
 								}
-								w->color = red;
+								w->set_color(red);
 								rb_tree_rotate_left(w, root);
 								w = x_parent->left;
 							}
-							w->color = x_parent->color;
-							x_parent->color = black;
+							w->set_color(x_parent->color());
+							x_parent->set_color(black);
 							if (w->left) {
-								w->left->color = black;
+								w->left->set_color(black);
 							}
 							rb_tree_rotate_right(x_parent, root);
 							break;
 						}
 					}
 				}
+				if (shrank != 0) {
+					*shrank = x == root && (x == 0 || x->color() == black);
+				}
 				if (x) {
-					x->color = black;
+					x->set_color(black);
 				}
 			}
 			return y;
@@ -951,44 +2761,44 @@ namespace ft
 	};
 
 	// Operator Overloading;
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator==(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator==(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 	}
 
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator<(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator<(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 	}
 
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator!=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator!=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return !(x == y);
 	}
 
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator>(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator>(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return y < x;
 	}
 
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator<=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator<=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return !(y < x);
 	}
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	bool	operator>=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	bool	operator>=(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		return!(x < y);
 	}
 
-	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc>
-	void	swap(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& x, \
-	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc>& y) {
+	template <class _Key, class _Val, class _KeyOfVal, class _Compare, class _Alloc, class _Augment>
+	void	swap(const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& x, \
+	const rbtree<_Key, _Val, _KeyOfVal, _Compare, _Alloc, _Augment>& y) {
 		x.swap(y);
 	}
 
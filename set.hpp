@@ -20,18 +20,19 @@ struct Identity
 };
 
 
-template<class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+template<class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>, \
+class Augment = rb_tree_no_augment>
 class set;
 
-template<class Key, class Compare, class Alloc>
-bool	operator==(const set<Key, Compare, Alloc>& x, \
-const set<Key, Compare, Alloc>& y);
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator==(const set<Key, Compare, Alloc, Augment>& x, \
+const set<Key, Compare, Alloc, Augment>& y);
 
-template<class Key, class Compare, class Alloc>
-bool	operator<(const set<Key, Compare, Alloc>& x, \
-const set<Key, Compare, Alloc>& y);
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator<(const set<Key, Compare, Alloc, Augment>& x, \
+const set<Key, Compare, Alloc, Augment>& y);
 
-template<class Key, class Compare, class Alloc>
+template<class Key, class Compare, class Alloc, class Augment>
 class set {
 public:
 	typedef Key				key_type;
@@ -41,7 +42,7 @@ public:
 
 private:
 	typedef ft::Identity<value_type>	key_of_value;
-	typedef rbtree<key_type, value_type, key_of_value, key_compare, Alloc>	rbtree_type;
+	typedef rbtree<key_type, value_type, key_of_value, key_compare, Alloc, Augment>	rbtree_type;
 	rbtree_type	tree;
 
 public:
@@ -56,6 +57,8 @@ public:
 	typedef typename rbtree_type::size_type					size_type;
 	typedef typename rbtree_type::difference_type			difference_type;
 	typedef typename rbtree_type::allocator_type			allocator_type;
+	typedef typename rbtree_type::node_handle				node_type;
+	typedef typename rbtree_type::template node_insert_return<iterator>	insert_return_type;
 
 	explicit set(const Compare& comp = key_compare(), const allocator_type& a = allocator_type())
 	: tree(comp, a) {}
@@ -67,14 +70,24 @@ public:
 		tree.insert(first, last);
 	}
 
-	set(const set<Key, Compare, Alloc>& x)
+	set(const set<Key, Compare, Alloc, Augment>& x)
 	: tree(x.tree) {}
 
+#if __cplusplus >= 201103L
+	set(set<Key, Compare, Alloc, Augment>&& x)
+	: tree(std::move(x.tree)) {}
+
+	set<Key, Compare, Alloc, Augment>& operator=(set<Key, Compare, Alloc, Augment>&& x) {
+		tree = std::move(x.tree);
+		return *this;
+	}
+#endif
+
 	~set() {
 		clear();
 	}
 
-	set<Key, Compare, Alloc>& operator=(const set<Key, Compare, Alloc>& x) {
+	set<Key, Compare, Alloc, Augment>& operator=(const set<Key, Compare, Alloc, Augment>& x) {
 		tree = x.tree;
 		return *this;
 	}
@@ -136,7 +149,7 @@ public:
 		return tree.max_size();
 	}
 
-	void				swap(set<Key, Compare, Alloc>& x) {
+	void				swap(set<Key, Compare, Alloc, Augment>& x) {
 		tree.swap(x.tree);
 	}
 
@@ -151,6 +164,30 @@ public:
 		return tree.insert((rbtree_iterator&)position, x);
 	}
 
+#if __cplusplus >= 201103L
+	ft::pair<iterator, bool>	insert(value_type&& x) {
+		ft::pair<typename rbtree_type::iterator, bool>	p = tree.insert(std::move(x));
+		return ft::pair<iterator, bool>(p.first, p.second);
+	}
+
+	iterator	insert(iterator position, value_type&& x) {
+		typedef typename rbtree_type::iterator	rbtree_iterator;
+		return tree.insert((rbtree_iterator&)position, std::move(x));
+	}
+
+	template <class... Args>
+	ft::pair<iterator, bool>	emplace(Args&&... args) {
+		ft::pair<typename rbtree_type::iterator, bool>	p = tree.emplace(std::forward<Args>(args)...);
+		return ft::pair<iterator, bool>(p.first, p.second);
+	}
+
+	template <class... Args>
+	iterator	emplace_hint(iterator position, Args&&... args) {
+		typedef typename rbtree_type::iterator	rbtree_iterator;
+		return tree.emplace_hint((rbtree_iterator&)position, std::forward<Args>(args)...);
+	}
+#endif
+
 	template<class InputIterator>
 	void		insert(InputIterator first, InputIterator last) {
 		tree.insert(first, last);
@@ -174,6 +211,80 @@ public:
 		tree.clear();
 	}
 
+	// node handles; the nodes are relinked, not reallocated
+	node_type	extract(iterator position) {
+		typedef typename rbtree_type::iterator	rbtree_iterator;
+		return tree.extract((rbtree_iterator&)position);
+	}
+
+	node_type	extract(const key_type& x) {
+		return tree.extract(x);
+	}
+
+#if __cplusplus >= 201103L
+	insert_return_type	insert(node_type&& nh) {
+		typename rbtree_type::insert_return_type	r = tree.insert(std::move(nh));
+		return insert_return_type(r.position, r.inserted, std::move(r.node));
+	}
+
+	iterator	insert(iterator position, node_type&& nh) {
+		typedef typename rbtree_type::iterator	rbtree_iterator;
+		return tree.insert((rbtree_iterator&)position, std::move(nh));
+	}
+
+	void		merge(set<Key, Compare, Alloc, Augment>&& source) {
+		tree.merge(source.tree);
+	}
+#else
+	insert_return_type	insert(const node_type& nh) {
+		typename rbtree_type::insert_return_type	r = tree.insert(nh);
+		return insert_return_type(r.position, r.inserted, r.node);
+	}
+
+	iterator	insert(iterator position, const node_type& nh) {
+		typedef typename rbtree_type::iterator	rbtree_iterator;
+		return tree.insert((rbtree_iterator&)position, nh);
+	}
+#endif
+
+	void		merge(set<Key, Compare, Alloc, Augment>& source) {
+		tree.merge(source.tree);
+	}
+
+	// split and join relink the nodes: split() leaves the keys below k
+	// here and returns the rest, join() appends a set whose keys are all
+	// greater and empties it. join() is O(log n), and so is split() when
+	// Augment keeps subtree sizes; a set without them pays a linear count
+	// of the smaller side to split
+	set<Key, Compare, Alloc, Augment>		split(const key_type& k) {
+		set<Key, Compare, Alloc, Augment>	upper(key_comp(), get_allocator());
+		tree.split(k, upper.tree);
+		return upper;
+	}
+
+	void		join(set<Key, Compare, Alloc, Augment>& other) {
+		tree.join(other.tree);
+	}
+
+	// set algebra in place against a set ordered the same way; see also
+	// the ft::set_union() family below, which builds a new set. Should
+	// copying one of other's elements throw, this set is left unchanged
+	void		union_with(const set<Key, Compare, Alloc, Augment>& other) {
+		tree.set_operation(other.tree, ft::set_union_op);
+	}
+
+	void		intersect_with(const set<Key, Compare, Alloc, Augment>& other) {
+		tree.set_operation(other.tree, ft::set_intersection_op);
+	}
+
+	void		difference_with(const set<Key, Compare, Alloc, Augment>& other) {
+		tree.set_operation(other.tree, ft::set_difference_op);
+	}
+
+	void		symmetric_difference_with(const set<Key, Compare, Alloc, Augment>& other) {
+		tree.set_operation(other.tree, ft::set_symmetric_difference_op);
+	}
+
 	iterator	find(const key_type& x) const {
 		return tree.find(x);
 	}
@@ -197,44 +308,138 @@ public:
 		return tree.equal_range(x);
 	}
 
-	template<class K1, class C1, class A1>
-	friend bool operator==(const set<K1, C1, A1>& x, const set<K1, C1, A1>& y);
-	template<class K1, class C1, class A1>
-	friend bool operator<(const set<K1, C1, A1>& x, const set<K1, C1, A1>& y);
+	// heterogeneous lookup, enabled when Compare has is_transparent
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	find(const K& x) const {
+		return tree.find(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, size_type>::type
+	count(const K& x) const {
+		return tree.count(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	lower_bound(const K& x) const {
+		return tree.lower_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, iterator>::type
+	upper_bound(const K& x) const {
+		return tree.upper_bound(x);
+	}
+
+	template <class K>
+	typename ft::enable_if_transparent<Compare, K, pair<iterator, iterator> >::type
+	equal_range(const K& x) const {
+		return tree.equal_range(x);
+	}
+
+	// order statistics, O(log n) with Augment = rb_tree_size_augment
+	iterator	nth(size_type k) const {
+		return tree.nth(k);
+	}
+
+	size_type	rank(const key_type& x) const {
+		return tree.rank(x);
+	}
+
+	difference_type	distance(iterator first, iterator last) const {
+		return tree.distance(first, last);
+	}
+
+	// an iterator per key of [first, last) to out, end() when absent; the
+	// lookups are interleaved to overlap their cache misses
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator	find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+		return tree.find_many(first, last, out);
+	}
+
+	// f on every element in order, or on the keys in [lo, hi); faster
+	// than an iterator loop when only the elements are wanted
+	template <class Function>
+	Function	for_each(Function f) const {
+		return tree.for_each(f);
+	}
+
+	template <class Function>
+	Function	for_each_range(const key_type& lo, const key_type& hi, Function f) const {
+		return tree.for_each_range(lo, hi, f);
+	}
+
+	template<class K1, class C1, class A1, class U1>
+	friend bool operator==(const set<K1, C1, A1, U1>& x, const set<K1, C1, A1, U1>& y);
+	template<class K1, class C1, class A1, class U1>
+	friend bool operator<(const set<K1, C1, A1, U1>& x, const set<K1, C1, A1, U1>& y);
+	template<class K1, class C1, class A1, class U1>
+	friend set<K1, C1, A1, U1>	set_algebra(const set<K1, C1, A1, U1>& x, const set<K1, C1, A1, U1>& y, rb_tree_set_operation op);
 };
 
-template<class Key, class Compare, class Alloc>
-bool	operator==(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+set<Key, Compare, Alloc, Augment>	set_algebra(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y, rb_tree_set_operation op) {
+	set<Key, Compare, Alloc, Augment>	result(x.key_comp(), x.get_allocator());
+	result.tree.assign_set_operation(x.tree, y.tree, op);
+	return result;
+}
+
+// new sets out of two ordered the same way: a merge and a bulk build,
+// O(n + m), or O(m log(n / m)) work when one is far smaller
+template<class Key, class Compare, class Alloc, class Augment>
+set<Key, Compare, Alloc, Augment>	set_union(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
+	return set_algebra(x, y, ft::set_union_op);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+set<Key, Compare, Alloc, Augment>	set_intersection(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
+	return set_algebra(x, y, ft::set_intersection_op);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+set<Key, Compare, Alloc, Augment>	set_difference(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
+	return set_algebra(x, y, ft::set_difference_op);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+set<Key, Compare, Alloc, Augment>	set_symmetric_difference(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
+	return set_algebra(x, y, ft::set_symmetric_difference_op);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator==(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return x.tree == y.tree;
 }
 
-template<class Key, class Compare, class Alloc>
-bool	operator<(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator<(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return x.tree < y.tree;
 }
 
-template<class Key, class Compare, class Alloc>
-bool	operator!=(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator!=(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return !(x == y);
 }
 
-template<class Key, class Compare, class Alloc>
-bool	operator>(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator>(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return y < x;
 }
 
-template<class Key, class Compare, class Alloc>
-bool	operator<=(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator<=(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return !(y < x);
 }
 
-template<class Key, class Compare, class Alloc>
-bool	operator>=(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+bool	operator>=(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	return !(x < y);
 }
 
-template<class Key, class Compare, class Alloc>
-void	swap(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y) {
+template<class Key, class Compare, class Alloc, class Augment>
+void	swap(const set<Key, Compare, Alloc, Augment>& x, const set<Key, Compare, Alloc, Augment>& y) {
 	x.swap(y);
 }
 
@@ -0,0 +1,708 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include "iterator.hpp"
+#include "algobase.hpp"
+#include "growth_policy.hpp"
+
+namespace ft
+{
+// ft::vector that keeps its first N elements inside the object itself and
+// only goes to the allocator once it outgrows them;
+template <class T, std::size_t N, class Allocator = std::allocator<T>, class Growth = ft::growth_double>
+class small_vector {
+public:
+	typedef typename Allocator::reference				reference;
+	typedef typename Allocator::const_reference 		const_reference;
+	typedef std::size_t									size_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef T											value_type;
+	typedef Allocator									allocator_type;
+	typedef typename Allocator::pointer					pointer;
+	typedef typename Allocator::const_pointer			const_pointer;
+	typedef pointer										iterator;
+	typedef const_pointer								const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+	typedef Growth										growth_policy;
+
+	static const size_type	inline_capacity = N;
+
+public:
+	explicit small_vector(const Allocator& alloc = Allocator())
+	: data_allocator(alloc), start(inline_data()), finish(start), end_of_storage(start + N) {}
+
+	explicit small_vector(size_type n, const T& value = T(), const Allocator& alloc = Allocator())
+	: data_allocator(alloc), start(inline_data()), finish(start), end_of_storage(start + N) {
+		try
+		{
+			reserve(n);
+			finish = construct_n(start, n, value);
+		}
+		catch(...)
+		{
+			release_storage();
+			throw;
+		}
+	}
+
+	template <class InputIterator>
+	small_vector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator(), \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0)
+	: data_allocator(alloc), start(inline_data()), finish(start), end_of_storage(start + N) {
+		try
+		{
+			insert(end(), first, last);
+		}
+		catch(...)
+		{
+			destory_by_range(start, finish);
+			release_storage();
+			throw;
+		}
+	}
+
+	small_vector(const small_vector& x)
+	: data_allocator(x.data_allocator), start(inline_data()), finish(start), end_of_storage(start + N) {
+		// no destructor runs for a constructor that throws, so a heap
+		// buffer reserve() took has to be given back here;
+		try
+		{
+			reserve(x.size());
+			finish = construct_by_range(x.begin(), x.end(), start);
+		}
+		catch(...)
+		{
+			release_storage();
+			throw;
+		}
+	}
+
+	~small_vector() {
+		destory_by_range(start, finish);
+		release_storage();
+	}
+
+	small_vector& operator=(const small_vector& x) {
+		if (this != &x) {
+			const size_type	x_size = x.size();
+			if (capacity() < x_size) {
+				pointer	new_start = allocate_n(x_size);
+				try
+				{
+					construct_by_range(x.begin(), x.end(), new_start);
+				}
+				catch(...)
+				{
+					deallocate_n_from(new_start, x_size);
+					throw;
+				}
+				destory_by_range(start, finish);
+				release_storage();
+				start = new_start;
+				end_of_storage = start + x_size;
+			} else if (size() >= x_size) {
+				iterator	i(std::copy(x.begin(), x.end(), begin()));
+				destory_by_range(i, end());
+			} else {
+				std::copy(x.begin(), x.begin() + size(), start);
+				construct_by_range(x.begin() + size(), x.end(), finish);
+			}
+			finish = start + x_size;
+		}
+		return *this;
+	}
+
+	template <class InputIterator>
+	void assign(InputIterator first, InputIterator last, \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
+		clear();
+		insert(end(), first, last);
+	}
+
+	void assign(size_type n, const T& u) {
+		clear();
+		insert(end(), n, u);
+	}
+
+	allocator_type get_allocator() const {
+		return data_allocator;
+	}
+
+	// iterators;
+	iterator				begin() {
+		return iterator(start);
+	}
+
+	const_iterator			begin() const {
+		return const_iterator(start);
+	}
+
+	iterator				end() {
+		return iterator(finish);
+	}
+
+	const_iterator			end() const {
+		return const_iterator(finish);
+	}
+
+	reverse_iterator		rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator	rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator		rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator	rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type				size() const {
+		return size_type(end() - begin());
+	}
+
+	size_type				max_size() const {
+		return std::min<size_type>(data_allocator.max_size(), std::numeric_limits<difference_type>::max());
+	}
+
+	void					resize(size_type sz, T c = T()) {
+		if (sz > size()) {
+			insert(end(), sz - size(), c);
+		} else if (sz < size()) {
+			erase(begin() + sz, end());
+		}
+	}
+
+	size_type				capacity() const {
+		return size_type(end_of_storage - start);
+	}
+
+	bool					empty() const {
+		return begin() == end();
+	}
+
+	void					reserve(size_type n) {
+		if (capacity() < n) {
+			if (n > max_size()) {
+				std::__throw_length_error("small_vector");
+			}
+			relocate_storage(n, relocate_category());
+		}
+	}
+
+	// true while the elements still live in the inline buffer;
+	bool					is_inline() const {
+		return start == inline_data();
+	}
+
+	// element access;
+	reference				operator[](size_type n) {
+		return *(begin() + n);
+	}
+
+	const_reference			operator[](size_type n) const {
+		return *(begin() + n);
+	}
+
+	reference				at(size_type n) {
+		if (n < size()) {
+			return (*this)[n];
+		} else {
+			std::__throw_out_of_range("small_vector");
+		}
+	}
+
+	const_reference			at(size_type n) const {
+		if (n < size()) {
+			return (*this)[n];
+		} else {
+			std::__throw_out_of_range("small_vector");
+		}
+	}
+
+	reference				front() {
+		return *begin();
+	}
+
+	const_reference			front() const {
+		return *begin();
+	}
+
+	reference				back() {
+		return *(end() - 1);
+	}
+
+	const_reference			back() const {
+		return *(end() - 1);
+	}
+
+	// modifiers
+	void		push_back(const T& x) {
+		if (finish != end_of_storage) {
+			data_allocator.construct(finish, x);
+			++finish;
+		} else {
+			insert(end(), x);
+		}
+	}
+
+#if __cplusplus >= 201103L
+	void		push_back(T&& x) {
+		emplace_back(std::move(x));
+	}
+
+	template <class... Args>
+	void		emplace_back(Args&&... args) {
+		if (finish == end_of_storage) {
+			T	x_tmp(std::forward<Args>(args)...);
+			relocate_storage(next_capacity(1), relocate_category());
+			alloc_traits::construct(data_allocator, finish, std::move(x_tmp));
+		} else {
+			alloc_traits::construct(data_allocator, finish, std::forward<Args>(args)...);
+		}
+		++finish;
+	}
+#endif
+
+	void		pop_back() {
+		--finish;
+		data_allocator.destroy(finish);
+	}
+
+	iterator	insert(iterator position, const T& x) {
+		const size_type	n = position - begin();
+		if (finish == end_of_storage) {
+			T	x_copy = x;
+			relocate_storage(next_capacity(1), relocate_category());
+			return insert(begin() + n, x_copy);
+		}
+		if (position == end()) {
+			data_allocator.construct(finish, x);
+			++finish;
+		} else {
+			data_allocator.construct(finish, *(finish - 1));
+			++finish;
+			T	x_copy = x;
+			std::copy_backward(position, iterator(finish - 2), iterator(finish - 1));
+			*position = x_copy;
+		}
+		return begin() + n;
+	}
+
+#if __cplusplus >= 201103L
+	iterator	insert(iterator position, T&& x) {
+		return emplace(position, std::move(x));
+	}
+
+	template <class... Args>
+	iterator	emplace(iterator position, Args&&... args) {
+		const size_type	n = position - begin();
+		if (finish == end_of_storage) {
+			T	x_tmp(std::forward<Args>(args)...);
+			relocate_storage(next_capacity(1), relocate_category());
+			return emplace(begin() + n, std::move(x_tmp));
+		}
+		if (position == end()) {
+			alloc_traits::construct(data_allocator, finish, std::forward<Args>(args)...);
+			++finish;
+		} else {
+			T	x_tmp(std::forward<Args>(args)...);
+			alloc_traits::construct(data_allocator, finish, std::move(*(finish - 1)));
+			++finish;
+			std::move_backward(position, iterator(finish - 2), iterator(finish - 1));
+			*position = std::move(x_tmp);
+		}
+		return begin() + n;
+	}
+#endif
+
+	void		insert(iterator position, size_type n, const T& x) {
+		if (n == 0) {
+			return ;
+		}
+		if (size_type(end_of_storage - finish) < n) {
+			const size_type	offset = position - begin();
+			T	x_copy = x;
+			relocate_storage(next_capacity(n), relocate_category());
+			insert(begin() + offset, n, x_copy);
+			return ;
+		}
+		T	x_copy = x;
+		const size_type elem_after = end() - position;
+		iterator	old_finish(finish);
+		if (elem_after > n) {
+			construct_by_range(finish - n, finish, finish);
+			finish += n;
+			std::copy_backward(position, old_finish - n, old_finish);
+			std::fill(position, position + n, x_copy);
+		} else {
+			construct_n(finish, n - elem_after, x_copy);
+			finish += n - elem_after;
+			construct_by_range(position, old_finish, finish);
+			finish += elem_after;
+			std::fill(position, old_finish, x_copy);
+		}
+	}
+
+	template <class InputIterator>
+	void		insert(iterator position, InputIterator first, InputIterator last, \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
+		typedef typename iterator_traits<InputIterator>::iterator_category	IterCategory;
+		range_insert(position, first, last, IterCategory());
+	}
+
+	iterator	erase(iterator position) {
+		if (position + 1 != end()) {
+			std::copy(position + 1, end(), position);
+		}
+		--finish;
+		data_allocator.destroy(finish);
+		return position;
+	}
+
+	iterator	erase(iterator first, iterator last) {
+		// moving the tail onto itself would empty its elements;
+		if (first == last) {
+			return first;
+		}
+#if __cplusplus >= 201103L
+		iterator	tmp = std::move(last, end(), first);
+#else
+		iterator	tmp = std::copy(last, end(), first);
+#endif
+
+		destory_by_range(tmp, end());
+		finish = finish - (last - first);
+		return first;
+	}
+
+	// O(1) erase for unordered contents: back() is moved into the hole;
+	// returns position, which now holds the former back();
+	iterator	unordered_erase(iterator position) {
+		if (position + 1 != end()) {
+#if __cplusplus >= 201103L
+			*position = std::move(*(end() - 1));
+#else
+			*position = *(end() - 1);
+#endif
+		}
+		pop_back();
+		return position;
+	}
+
+	// refills [first, last) from the tail, so at most last - first
+	// elements move, however long the vector is;
+	iterator	unordered_erase(iterator first, iterator last) {
+		const size_type	n = last - first;
+		const size_type	elem_after = end() - last;
+
+#if __cplusplus >= 201103L
+		std::move(end() - std::min(n, elem_after), end(), first);
+#else
+		std::copy(end() - std::min(n, elem_after), end(), first);
+#endif
+		destory_by_range(end() - n, end());
+		finish -= n;
+		return first;
+	}
+
+	// heap buffers trade pointers; anything inline has to be copied;
+	void		swap(small_vector& x) {
+		if (!is_inline() && !x.is_inline()) {
+			std::swap(data_allocator, x.data_allocator);
+			std::swap(start, x.start);
+			std::swap(finish, x.finish);
+			std::swap(end_of_storage, x.end_of_storage);
+		} else {
+			small_vector	tmp(*this);
+			*this = x;
+			x = tmp;
+		}
+	}
+
+	void		clear() {
+		erase(begin(), end());
+	}
+
+private:
+	typedef typename ft::is_trivially_copyable<T>::type		trivial_category;
+	typedef typename ft::is_trivially_relocatable<T>::type	relocate_category;
+#if __cplusplus >= 201103L
+	typedef std::allocator_traits<Allocator>				alloc_traits;
+#endif
+
+	typedef ft::aligned_buffer<T, N>						inline_storage;
+
+	allocator_type	data_allocator;
+	pointer			start;
+	pointer			finish;
+	pointer			end_of_storage;
+	inline_storage	storage;
+
+	pointer			inline_data() {
+		return reinterpret_cast<pointer>(storage.bytes);
+	}
+
+	const_pointer	inline_data() const {
+		return reinterpret_cast<const_pointer>(storage.bytes);
+	}
+
+	size_type		next_capacity(size_type n) const {
+		const size_type	old_size = size();
+		if (max_size() - old_size < n) {
+			std::__throw_length_error("small_vector");
+		}
+		size_type	len = Growth::next_capacity(old_size, old_size + n, sizeof(T));
+		if (len < old_size + n || len > max_size()) {
+			len = std::max(old_size + n, std::min(len, max_size()));
+		}
+		return len;
+	}
+
+	void			relocate_storage(size_type n, false_type) {
+		const size_type	old_size = size();
+		pointer			new_start = allocate_n(n);
+
+		try
+		{
+			relocate_by_range(start, finish, new_start);
+		}
+		catch(...)
+		{
+			deallocate_n_from(new_start, n);
+			throw;
+		}
+		destory_by_range(start, finish);
+		release_storage();
+		start = new_start;
+		finish = new_start + old_size;
+		end_of_storage = new_start + n;
+	}
+
+	// copy before C++11; afterwards move, unless moving could throw;
+	pointer			relocate_by_range(pointer r_first, pointer r_last, pointer d_first) {
+#if __cplusplus >= 201103L
+		pointer	curr = d_first;
+
+		try
+		{
+			for (; r_first != r_last; ++r_first, ++curr) {
+				alloc_traits::construct(data_allocator, curr, std::move_if_noexcept(*r_first));
+			}
+		}
+		catch(...)
+		{
+			destory_by_range(d_first, curr);
+			throw;
+		}
+		return curr;
+#else
+		return construct_by_range(r_first, r_last, d_first);
+#endif
+	}
+
+	void			relocate_storage(size_type n, true_type) {
+		const size_type	old_size = size();
+		pointer			new_start = allocate_n(n);
+
+		if (old_size != 0) {
+			std::memcpy(static_cast<void*>(new_start), static_cast<const void*>(start), old_size * sizeof(T));
+		}
+		release_storage();
+		start = new_start;
+		finish = new_start + old_size;
+		end_of_storage = new_start + n;
+	}
+
+	void			release_storage() {
+		if (!is_inline()) {
+			deallocate_n_from(start, end_of_storage - start);
+		}
+	}
+
+	pointer			allocate_n(size_type n) {
+		return data_allocator.allocate(n);
+	}
+
+	void			deallocate_n_from(pointer first, size_type n) {
+		if (first) {
+			data_allocator.deallocate(first, n);
+		}
+	}
+
+	template<typename Iterator>
+	pointer			construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, \
+	typename ft::enable_if<!ft::is_integral<Iterator>::value, Iterator>::type* = 0) {
+		return do_construct_by_range(r_first, r_last, d_first, trivial_category());
+	}
+
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, false_type) {
+		pointer	curr = d_first;
+
+		for (; r_first != r_last; ++r_first, ++curr) {
+			try
+			{
+				data_allocator.construct(curr, *(r_first));
+			}
+			catch(...)
+			{
+				destory_by_range(d_first, curr);
+				throw;
+			}
+		}
+		return curr;
+	}
+
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, true_type) {
+		return do_construct_by_range(r_first, r_last, d_first, false_type());
+	}
+
+	pointer			do_construct_by_range(pointer r_first, pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	pointer			do_construct_by_range(const_pointer r_first, const_pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	pointer			copy_trivial(const_pointer r_first, const_pointer r_last, pointer d_first) {
+		const size_type	n = r_last - r_first;
+		if (n != 0) {
+			std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(r_first), n * sizeof(T));
+		}
+		return d_first + n;
+	}
+
+	pointer			construct_n(pointer first, size_type n, const T& value) {
+		return do_construct_n(first, n, value, trivial_category());
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, false_type) {
+		pointer	curr = first;
+
+		try
+		{
+			for (; n > 0; --n, ++curr) {
+				data_allocator.construct(curr, value);
+			}
+		}
+		catch(...)
+		{
+			destory_by_range(first, curr);
+			throw;
+		}
+		return curr;
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, true_type) {
+		std::fill_n(first, n, value);
+		return first + n;
+	}
+
+	template <class Iterator>
+	void			destory_by_range(Iterator r_first, Iterator r_last) {
+		do_destroy_by_range(r_first, r_last, trivial_category());
+	}
+
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator r_first, Iterator r_last, false_type) {
+		for (; r_first != r_last; r_first++) {
+			data_allocator.destroy(r_first);
+		}
+	}
+
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator, Iterator, true_type) {}
+
+	template<class InputIterator>
+	void	range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+		for (; first != last; ++first) {
+			position = insert(position, *first);
+			++position;
+		}
+	}
+
+	template<class ForwardIterator>
+	void	range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		if (first == last) {
+			return ;
+		}
+		const size_type	n = ft::distance(first, last);
+		if (size_type(end_of_storage - finish) < n) {
+			const size_type	offset = position - begin();
+			relocate_storage(next_capacity(n), relocate_category());
+			position = begin() + offset;
+		}
+		const size_type	elem_after = end() - position;
+		iterator	old_finish(finish);
+		if (elem_after > n) {
+			construct_by_range(finish - n, finish, finish);
+			finish += n;
+			std::copy_backward(position, old_finish - n, old_finish);
+			std::copy(first, last, position);
+		} else {
+			ForwardIterator	mid = first;
+			for (size_type i = elem_after; i > 0; --i) {
+				mid++;
+			}
+			construct_by_range(mid, last, finish);
+			finish += n - elem_after;
+			construct_by_range(position, old_finish, finish);
+			finish += elem_after;
+			std::copy(first, mid, position);
+		}
+	}
+};
+
+// Operator Overloading;
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator==(const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator< (const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator!=(const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return !(x == y);
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator> (const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return y < x;
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator>=(const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return !(x < y);
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+bool	operator<=(const small_vector<T,N,Allocator,Growth>& x, const small_vector<T,N,Allocator,Growth>& y) {
+	return !(y < x);
+}
+
+template <class T, std::size_t N, class Allocator, class Growth>
+void	swap(small_vector<T,N,Allocator,Growth>& x, small_vector<T,N,Allocator,Growth>& y) {
+	x.swap(y);
+}
+
+}
+
+#endif
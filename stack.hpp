@@ -1,6 +1,7 @@
 #ifndef STACK_HPP
 #define STACK_HPP
 
+#include <utility>
 #include "vector.hpp"
 
 namespace ft
@@ -43,6 +44,17 @@ namespace ft
 			c.push_back(x);
 		}
 
+#if __cplusplus >= 201103L
+		void push(value_type&& x) {
+			c.push_back(std::move(x));
+		}
+
+		template <class... Args>
+		void emplace(Args&&... args) {
+			c.emplace_back(std::forward<Args>(args)...);
+		}
+#endif
+
 		void pop() {
 			c.pop_back();
 		}
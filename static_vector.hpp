@@ -0,0 +1,550 @@
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include <new>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "iterator.hpp"
+#include "algobase.hpp"
+
+namespace ft
+{
+// ft::vector with all of its storage inline and a fixed capacity: it never
+// allocates. Growing past Capacity throws std::length_error and leaves the
+// container untouched, except that insert() and assign() from an input
+// iterator range keep the elements added before the throw (assign() has
+// dropped the old ones by then); try_push_back() reports it with a bool;
+template <class T, std::size_t Capacity>
+class static_vector {
+public:
+	typedef T&											reference;
+	typedef const T&							 		const_reference;
+	typedef std::size_t									size_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef T											value_type;
+	typedef T*											pointer;
+	typedef const T*									const_pointer;
+	typedef pointer										iterator;
+	typedef const_pointer								const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+public:
+	static_vector()
+	: finish(start()) {}
+
+	explicit static_vector(size_type n, const T& value = T())
+	: finish(start()) {
+		check_room(n);
+		finish = construct_n(start(), n, value);
+	}
+
+	template <class InputIterator>
+	static_vector(InputIterator first, InputIterator last, \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0)
+	: finish(start()) {
+		insert(end(), first, last);
+	}
+
+	static_vector(const static_vector& x)
+	: finish(start()) {
+		finish = construct_by_range(x.begin(), x.end(), start());
+	}
+
+	~static_vector() {
+		destory_by_range(start(), finish);
+	}
+
+	static_vector& operator=(const static_vector& x) {
+		if (this != &x) {
+			const size_type	x_size = x.size();
+			if (size() >= x_size) {
+				iterator	i(std::copy(x.begin(), x.end(), begin()));
+				destory_by_range(i, end());
+			} else {
+				std::copy(x.begin(), x.begin() + size(), start());
+				construct_by_range(x.begin() + size(), x.end(), finish);
+			}
+			finish = start() + x_size;
+		}
+		return *this;
+	}
+
+	template <class InputIterator>
+	void assign(InputIterator first, InputIterator last, \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
+		typedef typename iterator_traits<InputIterator>::iterator_category	IterCategory;
+		range_assign(first, last, IterCategory());
+	}
+
+	void assign(size_type n, const T& u) {
+		reserve(n);
+		clear();
+		insert(end(), n, u);
+	}
+
+	// iterators;
+	iterator				begin() {
+		return iterator(start());
+	}
+
+	const_iterator			begin() const {
+		return const_iterator(start());
+	}
+
+	iterator				end() {
+		return iterator(finish);
+	}
+
+	const_iterator			end() const {
+		return const_iterator(finish);
+	}
+
+	reverse_iterator		rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator	rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator		rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator	rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type				size() const {
+		return size_type(end() - begin());
+	}
+
+	size_type				max_size() const {
+		return Capacity;
+	}
+
+	void					resize(size_type sz, T c = T()) {
+		if (sz > size()) {
+			insert(end(), sz - size(), c);
+		} else if (sz < size()) {
+			erase(begin() + sz, end());
+		}
+	}
+
+	size_type				capacity() const {
+		return Capacity;
+	}
+
+	bool					empty() const {
+		return begin() == end();
+	}
+
+	bool					full() const {
+		return size() == Capacity;
+	}
+
+	void					reserve(size_type n) {
+		if (n > Capacity) {
+			std::__throw_length_error("static_vector");
+		}
+	}
+
+	// element access;
+	reference				operator[](size_type n) {
+		return *(begin() + n);
+	}
+
+	const_reference			operator[](size_type n) const {
+		return *(begin() + n);
+	}
+
+	reference				at(size_type n) {
+		if (n < size()) {
+			return (*this)[n];
+		} else {
+			std::__throw_out_of_range("static_vector");
+		}
+	}
+
+	const_reference			at(size_type n) const {
+		if (n < size()) {
+			return (*this)[n];
+		} else {
+			std::__throw_out_of_range("static_vector");
+		}
+	}
+
+	reference				front() {
+		return *begin();
+	}
+
+	const_reference			front() const {
+		return *begin();
+	}
+
+	reference				back() {
+		return *(end() - 1);
+	}
+
+	const_reference			back() const {
+		return *(end() - 1);
+	}
+
+	// modifiers
+	void		push_back(const T& x) {
+		check_room(1);
+		construct(finish, x);
+		++finish;
+	}
+
+	bool		try_push_back(const T& x) {
+		if (full()) {
+			return false;
+		}
+		construct(finish, x);
+		++finish;
+		return true;
+	}
+
+#if __cplusplus >= 201103L
+	void		push_back(T&& x) {
+		emplace_back(std::move(x));
+	}
+
+	template <class... Args>
+	void		emplace_back(Args&&... args) {
+		check_room(1);
+		new(static_cast<void*>(finish)) T(std::forward<Args>(args)...);
+		++finish;
+	}
+#endif
+
+	void		pop_back() {
+		--finish;
+		destroy(finish);
+	}
+
+	iterator	insert(iterator position, const T& x) {
+		check_room(1);
+		if (position == end()) {
+			construct(finish, x);
+			++finish;
+		} else {
+			construct(finish, *(finish - 1));
+			++finish;
+			T	x_copy = x;
+			std::copy_backward(position, iterator(finish - 2), iterator(finish - 1));
+			*position = x_copy;
+		}
+		return position;
+	}
+
+	void		insert(iterator position, size_type n, const T& x) {
+		if (n == 0) {
+			return ;
+		}
+		check_room(n);
+		T	x_copy = x;
+		const size_type elem_after = end() - position;
+		iterator	old_finish(finish);
+		if (elem_after > n) {
+			construct_by_range(finish - n, finish, finish);
+			finish += n;
+			std::copy_backward(position, old_finish - n, old_finish);
+			std::fill(position, position + n, x_copy);
+		} else {
+			construct_n(finish, n - elem_after, x_copy);
+			finish += n - elem_after;
+			construct_by_range(position, old_finish, finish);
+			finish += elem_after;
+			std::fill(position, old_finish, x_copy);
+		}
+	}
+
+	template <class InputIterator>
+	void		insert(iterator position, InputIterator first, InputIterator last, \
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
+		typedef typename iterator_traits<InputIterator>::iterator_category	IterCategory;
+		range_insert(position, first, last, IterCategory());
+	}
+
+	iterator	erase(iterator position) {
+		if (position + 1 != end()) {
+			std::copy(position + 1, end(), position);
+		}
+		--finish;
+		destroy(finish);
+		return position;
+	}
+
+	iterator	erase(iterator first, iterator last) {
+		// moving the tail onto itself would empty its elements;
+		if (first == last) {
+			return first;
+		}
+#if __cplusplus >= 201103L
+		iterator	tmp = std::move(last, end(), first);
+#else
+		iterator	tmp = std::copy(last, end(), first);
+#endif
+
+		destory_by_range(tmp, end());
+		finish = finish - (last - first);
+		return first;
+	}
+
+	// O(1) erase for unordered contents: back() is moved into the hole;
+	// returns position, which now holds the former back();
+	iterator	unordered_erase(iterator position) {
+		if (position + 1 != end()) {
+#if __cplusplus >= 201103L
+			*position = std::move(*(end() - 1));
+#else
+			*position = *(end() - 1);
+#endif
+		}
+		pop_back();
+		return position;
+	}
+
+	// refills [first, last) from the tail, so at most last - first
+	// elements move, however long the vector is;
+	iterator	unordered_erase(iterator first, iterator last) {
+		const size_type	n = last - first;
+		const size_type	elem_after = end() - last;
+
+#if __cplusplus >= 201103L
+		std::move(end() - std::min(n, elem_after), end(), first);
+#else
+		std::copy(end() - std::min(n, elem_after), end(), first);
+#endif
+		destory_by_range(end() - n, end());
+		finish -= n;
+		return first;
+	}
+
+	void		swap(static_vector& x) {
+		static_vector&	longer = size() < x.size() ? x : *this;
+		static_vector&	shorter = size() < x.size() ? *this : x;
+		const size_type	common = shorter.size();
+
+		std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+		shorter.finish = construct_by_range(longer.begin() + common, longer.end(), shorter.finish);
+		longer.destory_by_range(longer.begin() + common, longer.end());
+		longer.finish = longer.start() + common;
+	}
+
+	void		clear() {
+		erase(begin(), end());
+	}
+
+private:
+	typedef typename ft::is_trivially_copyable<T>::type		trivial_category;
+
+	typedef ft::aligned_buffer<T, Capacity>					inline_storage;
+
+	pointer			finish;
+	inline_storage	storage;
+
+	pointer			start() {
+		return reinterpret_cast<pointer>(storage.bytes);
+	}
+
+	const_pointer	start() const {
+		return reinterpret_cast<const_pointer>(storage.bytes);
+	}
+
+	void			check_room(size_type n) const {
+		if (n > Capacity - size()) {
+			std::__throw_length_error("static_vector");
+		}
+	}
+
+	void			construct(pointer p, const T& x) {
+		new(static_cast<void*>(p)) T(x);
+	}
+
+	void			destroy(pointer p) {
+		p->~T();
+	}
+
+	template<typename Iterator>
+	pointer			construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, \
+	typename ft::enable_if<!ft::is_integral<Iterator>::value, Iterator>::type* = 0) {
+		return do_construct_by_range(r_first, r_last, d_first, trivial_category());
+	}
+
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, false_type) {
+		pointer	curr = d_first;
+
+		for (; r_first != r_last; ++r_first, ++curr) {
+			try
+			{
+				construct(curr, *(r_first));
+			}
+			catch(...)
+			{
+				destory_by_range(d_first, curr);
+				throw;
+			}
+		}
+		return curr;
+	}
+
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, true_type) {
+		return do_construct_by_range(r_first, r_last, d_first, false_type());
+	}
+
+	pointer			do_construct_by_range(pointer r_first, pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	pointer			do_construct_by_range(const_pointer r_first, const_pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	pointer			copy_trivial(const_pointer r_first, const_pointer r_last, pointer d_first) {
+		const size_type	n = r_last - r_first;
+		if (n != 0) {
+			std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(r_first), n * sizeof(T));
+		}
+		return d_first + n;
+	}
+
+	pointer			construct_n(pointer first, size_type n, const T& value) {
+		return do_construct_n(first, n, value, trivial_category());
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, false_type) {
+		pointer	curr = first;
+
+		try
+		{
+			for (; n > 0; --n, ++curr) {
+				construct(curr, value);
+			}
+		}
+		catch(...)
+		{
+			destory_by_range(first, curr);
+			throw;
+		}
+		return curr;
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, true_type) {
+		std::fill_n(first, n, value);
+		return first + n;
+	}
+
+	template <class Iterator>
+	void			destory_by_range(Iterator r_first, Iterator r_last) {
+		do_destroy_by_range(r_first, r_last, trivial_category());
+	}
+
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator r_first, Iterator r_last, false_type) {
+		for (; r_first != r_last; r_first++) {
+			destroy(r_first);
+		}
+	}
+
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator, Iterator, true_type) {}
+
+	template<class InputIterator>
+	void	range_assign(InputIterator first, InputIterator last, input_iterator_tag) {
+		clear();
+		insert(end(), first, last);
+	}
+
+	// the length is known up front, so an overflow throws before clear();
+	template<class ForwardIterator>
+	void	range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		if (size_type(ft::distance(first, last)) > Capacity) {
+			std::__throw_length_error("static_vector");
+		}
+		clear();
+		insert(end(), first, last);
+	}
+
+	template<class InputIterator>
+	void	range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+		for (; first != last; ++first) {
+			position = insert(position, *first);
+			++position;
+		}
+	}
+
+	template<class ForwardIterator>
+	void	range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		if (first == last) {
+			return ;
+		}
+		const size_type	n = ft::distance(first, last);
+		check_room(n);
+		const size_type	elem_after = end() - position;
+		iterator	old_finish(finish);
+		if (elem_after > n) {
+			construct_by_range(finish - n, finish, finish);
+			finish += n;
+			std::copy_backward(position, old_finish - n, old_finish);
+			std::copy(first, last, position);
+		} else {
+			ForwardIterator	mid = first;
+			for (size_type i = elem_after; i > 0; --i) {
+				mid++;
+			}
+			construct_by_range(mid, last, finish);
+			finish += n - elem_after;
+			construct_by_range(position, old_finish, finish);
+			finish += elem_after;
+			std::copy(first, mid, position);
+		}
+	}
+};
+
+// Operator Overloading;
+template <class T, std::size_t Capacity>
+bool	operator==(const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
+}
+
+template <class T, std::size_t Capacity>
+bool	operator< (const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, std::size_t Capacity>
+bool	operator!=(const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return !(x == y);
+}
+
+template <class T, std::size_t Capacity>
+bool	operator> (const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return y < x;
+}
+
+template <class T, std::size_t Capacity>
+bool	operator>=(const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return !(x < y);
+}
+
+template <class T, std::size_t Capacity>
+bool	operator<=(const static_vector<T,Capacity>& x, const static_vector<T,Capacity>& y) {
+	return !(y < x);
+}
+
+template <class T, std::size_t Capacity>
+void	swap(static_vector<T,Capacity>& x, static_vector<T,Capacity>& y) {
+	x.swap(y);
+}
+
+}
+
+#endif
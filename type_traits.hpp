@@ -1,6 +1,8 @@
 #ifndef TYPE_TRAITS_HPP
 #define TYPE_TRAITS_HPP
 
+#include <cstddef>
+
 namespace ft
 {
 	template <bool B, class T = void >
@@ -24,6 +26,18 @@ namespace ft
 	typedef integral_constant<bool, false>	false_type;
 	typedef integral_constant<bool, true>	true_type;
 
+	template <bool B, class T, class F>
+	struct conditional
+	{
+		typedef T type;
+	};
+
+	template <class T, class F>
+	struct conditional<false, T, F>
+	{
+		typedef F type;
+	};
+
 	template <class _Tp>
 	struct is_integral : public false_type {};
 
@@ -60,6 +74,49 @@ namespace ft
 	template<>
 	struct is_integral<unsigned long> : public true_type {};
 
+	template <class T>
+	struct is_pod : public integral_constant<bool, __is_pod(T)> {};
+
+	// specialize for non-POD types that can still be copied bytewise;
+	template <class T>
+	struct is_trivially_copyable : public is_pod<T> {};
+
+	// specialize for types that may be moved with memcpy and never
+	// destroyed at the old address, even if copying them is not trivial;
+	template <class T>
+	struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+	// comparators tagged with is_transparent accept any probe type;
+	template <class T>
+	struct has_is_transparent
+	{
+	private:
+		template <class U>
+		static char	test(typename U::is_transparent*);
+		template <class U>
+		static long	test(...);
+
+	public:
+		static const bool	value = (sizeof(test<T>(0)) == sizeof(char));
+	};
+
+	// K only makes the condition dependent, so that a member template of
+	// a class parameterized on Compare drops out instead of failing;
+	template <class Compare, class K, class R>
+	struct enable_if_transparent : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+	// uninitialized room for N objects of type T, aligned as strictly as
+	// T itself asks, over-aligned types included;
+	template <class T, std::size_t N>
+	struct aligned_buffer
+	{
+#if __cplusplus >= 201103L
+		alignas(T) char	bytes[N ? N * sizeof(T) : 1];
+#else
+		char	bytes[N ? N * sizeof(T) : 1] __attribute__((__aligned__(__alignof__(T))));
+#endif
+	};
+
 }
 
 #endif
@@ -4,12 +4,16 @@
 #include <memory>
 #include <algorithm>
 #include <cstring>
+#include <limits>
+#include <utility>
 #include "iterator.hpp"
 #include "algobase.hpp"
+#include "growth_policy.hpp"
+#include "malloc_allocator.hpp"
 
 namespace ft
 {
-template <class T, class Allocator = std::allocator<T> > class vector {
+template <class T, class Allocator = std::allocator<T>, class Growth = ft::growth_double> class vector {
 public:
 	typedef typename Allocator::reference				reference;
 	typedef typename Allocator::const_reference 		const_reference;
@@ -23,6 +27,7 @@ public:
 	typedef const_pointer								const_iterator;
 	typedef ft::reverse_iterator<iterator>				reverse_iterator;
 	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+	typedef Growth										growth_policy;
 
 public:
 	explicit vector(const Allocator& alloc = Allocator())
@@ -41,19 +46,11 @@ public:
 	vector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator(), \
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0)
 	: data_allocator(alloc), start(0), finish(0), end_of_storage(0) {
-		if (ft::is_input_iter<typename iterator_traits<InputIterator>::iterator_category>::value) {
-			for (; first != last; ++first) {
-				push_back(*(first));
-			}
-		} else {
-			size_type	n = ft::distance(first, last);
-			start = allocate_n(n);
-			end_of_storage = start + n;
-			finish = construct_by_range(first, last, start);
-		}
+		typedef typename iterator_traits<InputIterator>::iterator_category	IterCategory;
+		range_initialize(first, last, IterCategory());
 	}
 
-	vector(const vector<T,Allocator>& x)
+	vector(const vector<T,Allocator,Growth>& x)
 	: data_allocator(x.get_allocator()) {
 		start = allocate_n(x.size());
 		finish = start;
@@ -61,12 +58,21 @@ public:
 		finish = construct_by_range(x.begin(), x.end(), finish);
 	}
 
+#if __cplusplus >= 201103L
+	vector(vector<T,Allocator,Growth>&& x) noexcept
+	: data_allocator(x.data_allocator), start(x.start), finish(x.finish), end_of_storage(x.end_of_storage) {
+		x.start = 0;
+		x.finish = 0;
+		x.end_of_storage = 0;
+	}
+#endif
+
 	~vector() {
 		destory_by_range(start, finish);
 		deallocate_n_from(start, end_of_storage - start);
 	}
 
-	vector<T,Allocator>& operator=(const vector<T,Allocator>& x) {
+	vector<T,Allocator,Growth>& operator=(const vector<T,Allocator,Growth>& x) {
 		if (this != &x) {
 			const size_type	x_size = x.size();
 			if (capacity() < x_size) {
@@ -88,17 +94,35 @@ public:
 		return *this;
 	}
 
+#if __cplusplus >= 201103L
+	vector<T,Allocator,Growth>& operator=(vector<T,Allocator,Growth>&& x) noexcept {
+		if (this != &x) {
+			vector<T,Allocator,Growth>	tmp(std::move(x));
+			swap(tmp);
+		}
+		return *this;
+	}
+#endif
+
 	template <class InputIterator>
 	void assign(InputIterator first, InputIterator last, \
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
-		erase(begin(), end());
-		insert(begin(), first, last);
-
+		typedef typename iterator_traits<InputIterator>::iterator_category	IterCategory;
+		range_assign(first, last, IterCategory());
 	}
 
+	// reuses live elements and capacity the same way operator= does;
 	void assign(size_type n, const T& u) {
-		erase(begin(), end());
-		insert(begin(), n, u);
+		if (n > capacity()) {
+			vector<T,Allocator,Growth>	tmp(n, u, data_allocator);
+			swap(tmp);
+		} else if (n > size()) {
+			std::fill(begin(), end(), u);
+			finish = construct_n(finish, n - size(), u);
+		} else {
+			std::fill(begin(), begin() + n, u);
+			erase(begin() + n, end());
+		}
 	}
 
 	allocator_type get_allocator() const {
@@ -152,7 +176,28 @@ public:
 			insert(end(), sz - size(), c);
 		} else if (sz < size()) {
 			erase(begin() + sz, end());
-		} else ;
+		}
+	}
+
+	// like resize(), but new elements are default-initialized, which leaves
+	// them indeterminate for POD types instead of writing every slot;
+	void					resize_default_init(size_type sz) {
+		if (sz > size()) {
+			append_uninitialized(sz - size());
+		} else if (sz < size()) {
+			erase(begin() + sz, end());
+		}
+	}
+
+	// grows by n default-initialized elements and returns the first of them,
+	// for callers that are about to overwrite them (read(), decoders);
+	pointer					append_uninitialized(size_type n) {
+		if (size_type(end_of_storage - finish) < n) {
+			relocate_storage(next_capacity(n), relocate_category());
+		}
+		pointer	first = finish;
+		finish = default_construct_n(finish, n, pod_category());
+		return first;
 	}
 
 	size_type				capacity() const {
@@ -164,16 +209,10 @@ public:
 	}
 	void					reserve(size_type n) {
 		if (capacity() < n) {
-			const size_type	old_size = size();
-			pointer	new_start = allocate_n(n);
-
-			construct_by_range(start, finish, new_start);
-			destory_by_range(start, finish);
-			deallocate_n_from(start, end_of_storage - start);
-
-			start = new_start;
-			finish = new_start + old_size;
-			end_of_storage = start + n;
+			if (n > max_size()) {
+				std::__throw_length_error("vector");
+			}
+			relocate_storage(n, relocate_category());
 		}
 	}
 
@@ -226,6 +265,22 @@ public:
 		}
 	}
 
+#if __cplusplus >= 201103L
+	void		push_back(T&& x) {
+		emplace_back(std::move(x));
+	}
+
+	template <class... Args>
+	void		emplace_back(Args&&... args) {
+		if (finish != end_of_storage) {
+			alloc_traits::construct(data_allocator, finish, std::forward<Args>(args)...);
+			++finish;
+		} else {
+			emplace(end(), std::forward<Args>(args)...);
+		}
+	}
+#endif
+
 	void		pop_back() {
 		--finish;
 		data_allocator.destroy(finish);
@@ -233,6 +288,11 @@ public:
 
 	iterator	insert(iterator position, const T& x) {
 		size_type	n = position - begin();
+		if (finish == end_of_storage && relocate_category::value) {
+			T	x_copy = x;
+			relocate_storage(next_capacity(1), relocate_category());
+			return insert(begin() + n, x_copy);
+		}
 		if (finish != end_of_storage && position == end()) {
 			data_allocator.construct(finish, x);
 			++finish;
@@ -244,40 +304,73 @@ public:
 				std::copy_backward(position, iterator(finish - 2), iterator(finish - 1));
 				*position = x_copy;
 			} else {
-				const size_type	old_size = size();
-				size_type	new_capacity = 0;
-				if (old_size != 0) {
-					new_capacity = old_size * 2;
-				} else {
-					new_capacity = 1;
-				}
+				const size_type	new_capacity = next_capacity(1);
 				pointer	new_start = allocate_n(new_capacity);
-				pointer new_finish = new_start;
 				try
 				{
-					new_finish = construct_by_range(iterator(start), position, new_finish);
-					data_allocator.construct(new_finish, x);
-					++new_finish;
-					new_finish = construct_by_range(position, iterator(finish), new_finish);
+					data_allocator.construct(new_start + n, x);
 				}
 				catch(...)
 				{
-					destory_by_range(new_start, new_finish);
 					deallocate_n_from(new_start, new_capacity);
 					throw;
 				}
-				destory_by_range(start, finish);
-				deallocate_n_from(start, end_of_storage - start);
-				start = new_start;
-				finish = new_finish;
-				end_of_storage = new_start + new_capacity;
+				relocate_around_gap(new_start, new_capacity, n, 1);
+			}
+		}
+		return begin() + n;
+	}
+
+#if __cplusplus >= 201103L
+	iterator	insert(iterator position, T&& x) {
+		return emplace(position, std::move(x));
+	}
+
+	template <class... Args>
+	iterator	emplace(iterator position, Args&&... args) {
+		const size_type	n = position - begin();
+		if (finish != end_of_storage) {
+			if (position == end()) {
+				alloc_traits::construct(data_allocator, finish, std::forward<Args>(args)...);
+				++finish;
+			} else {
+				T	x_tmp(std::forward<Args>(args)...);
+				alloc_traits::construct(data_allocator, finish, std::move(*(finish - 1)));
+				++finish;
+				std::move_backward(position, iterator(finish - 2), iterator(finish - 1));
+				*position = std::move(x_tmp);
+			}
+		} else if (relocate_category::value) {
+			T	x_tmp(std::forward<Args>(args)...);
+			relocate_storage(next_capacity(1), relocate_category());
+			return emplace(begin() + n, std::move(x_tmp));
+		} else {
+			const size_type	new_capacity = next_capacity(1);
+			pointer	new_start = allocate_n(new_capacity);
+			try
+			{
+				alloc_traits::construct(data_allocator, new_start + n, std::forward<Args>(args)...);
 			}
+			catch(...)
+			{
+				deallocate_n_from(new_start, new_capacity);
+				throw;
+			}
+			relocate_around_gap(new_start, new_capacity, n, 1);
 		}
 		return begin() + n;
 	}
+#endif
 
 
 	void		insert(iterator position, size_type n, const T& x) {
+		if (size_type(end_of_storage - finish) < n && relocate_category::value) {
+			const size_type	offset = position - begin();
+			T	x_copy = x;
+			relocate_storage(next_capacity(n), relocate_category());
+			insert(begin() + offset, n, x_copy);
+			return;
+		}
 		if (n != 0) {
 			if (size_type(end_of_storage - finish) >= n) {
 				T	x_copy = x;
@@ -297,27 +390,19 @@ public:
 					std::fill(position, old_finish, x_copy);
 				}
 			} else {
-				const size_type	old_size = size();
-				const size_type	len = old_size + std::max(old_size, n);
-				iterator	new_start(allocate_n(len));
-				iterator	new_finish(new_start);
+				const size_type	len = next_capacity(n);
+				const size_type	offset = position - begin();
+				pointer			new_start = allocate_n(len);
 				try
 				{
-					new_finish = construct_by_range(begin(), position, new_start);
-					new_finish = construct_n(new_finish, n, x);
-					new_finish = construct_by_range(position, end(), new_finish);
+					construct_n(new_start + offset, n, x);
 				}
 				catch(...)
 				{
-					destory_by_range(new_start, new_finish);
 					deallocate_n_from(new_start, len);
 					throw;
 				}
-				destory_by_range(start, finish);
-				deallocate_n_from(start, end_of_storage - start);
-				start = new_start;
-				finish = new_finish;
-				end_of_storage = new_start + len;
+				relocate_around_gap(new_start, len, offset, n);
 			}
 		}
 	}
@@ -339,14 +424,85 @@ public:
 	}
 
 	iterator	erase(iterator first, iterator last) {
+		// moving the tail onto itself would empty its elements;
+		if (first == last) {
+			return first;
+		}
+#if __cplusplus >= 201103L
+		iterator	tmp = std::move(last, end(), first);
+#else
 		iterator	tmp = std::copy(last, end(), first);
+#endif
 
 		destory_by_range(tmp, end());
 		finish = finish - (last - first);
 		return first;
 	}
 
-	void		swap(vector<T,Allocator>& x) {
+	// erases the elements at `first`..`last`, iterators into this vector in
+	// ascending order (repeats are ignored); the survivors are compacted in
+	// a single pass and the tail destroyed once;
+	template <class PositionIterator>
+	size_type	erase_sorted(PositionIterator first, PositionIterator last) {
+		if (first == last) {
+			return 0;
+		}
+		iterator	dest = begin() + (*first - begin());
+		iterator	src = dest;
+		for (; first != last; ++first) {
+			iterator	position = begin() + (*first - begin());
+			if (position < src) {
+				continue ;
+			}
+#if __cplusplus >= 201103L
+			dest = std::move(src, position, dest);
+#else
+			dest = std::copy(src, position, dest);
+#endif
+			src = position + 1;
+		}
+#if __cplusplus >= 201103L
+		dest = std::move(src, end(), dest);
+#else
+		dest = std::copy(src, end(), dest);
+#endif
+		const size_type	n = end() - dest;
+		destory_by_range(dest, end());
+		finish = dest;
+		return n;
+	}
+
+	// O(1) erase for unordered contents: back() is moved into the hole;
+	// returns position, which now holds the former back();
+	iterator	unordered_erase(iterator position) {
+		if (position + 1 != end()) {
+#if __cplusplus >= 201103L
+			*position = std::move(*(end() - 1));
+#else
+			*position = *(end() - 1);
+#endif
+		}
+		pop_back();
+		return position;
+	}
+
+	// refills [first, last) from the tail, so at most last - first
+	// elements move, however long the vector is;
+	iterator	unordered_erase(iterator first, iterator last) {
+		const size_type	n = last - first;
+		const size_type	elem_after = end() - last;
+
+#if __cplusplus >= 201103L
+		std::move(end() - std::min(n, elem_after), end(), first);
+#else
+		std::copy(end() - std::min(n, elem_after), end(), first);
+#endif
+		destory_by_range(end() - n, end());
+		finish -= n;
+		return first;
+	}
+
+	void		swap(vector<T,Allocator,Growth>& x) {
 		std::swap(data_allocator, x.data_allocator);
 		std::swap(start, x.start);
 		std::swap(finish, x.finish);
@@ -358,6 +514,14 @@ public:
 	}
 
 private:
+	typedef typename ft::is_trivially_copyable<T>::type		trivial_category;
+	typedef typename ft::is_pod<T>::type					pod_category;
+	typedef typename ft::is_trivially_relocatable<T>::type	relocate_category;
+	typedef typename ft::is_reallocatable<Allocator>::type	reallocate_category;
+#if __cplusplus >= 201103L
+	typedef std::allocator_traits<Allocator>				alloc_traits;
+#endif
+
 	allocator_type	data_allocator;
 	pointer			start;
 	pointer			finish;
@@ -367,6 +531,109 @@ private:
 		return data_allocator.allocate(n);
 	}
 
+	// capacity for `n` more elements, as chosen by the growth policy;
+	size_type		next_capacity(size_type n) const {
+		const size_type	old_size = size();
+		if (max_size() - old_size < n) {
+			std::__throw_length_error("vector");
+		}
+		size_type	len = Growth::next_capacity(old_size, old_size + n, sizeof(T));
+		if (len < old_size + n || len > max_size()) {
+			len = std::max(old_size + n, std::min(len, max_size()));
+		}
+		return len;
+	}
+
+	// move every element into storage for `n` elements;
+	void			relocate_storage(size_type n, false_type) {
+		relocate_around_gap(allocate_n(n), n, size(), 0);
+	}
+
+	// adopts new_start, a buffer of len elements whose
+	// [offset, offset + gap) slots the caller already constructed, after
+	// moving the current elements around that gap; on failure the new
+	// buffer is released and *this is left untouched;
+	void			relocate_around_gap(pointer new_start, size_type len, size_type offset, size_type gap) {
+		pointer	gap_first = new_start + offset;
+		pointer	position = start + offset;
+		pointer	new_finish;
+
+		try
+		{
+			relocate_by_range(start, position, new_start);
+		}
+		catch(...)
+		{
+			destory_by_range(gap_first, gap_first + gap);
+			deallocate_n_from(new_start, len);
+			throw;
+		}
+		try
+		{
+			new_finish = relocate_by_range(position, finish, gap_first + gap);
+		}
+		catch(...)
+		{
+			destory_by_range(new_start, gap_first + gap);
+			deallocate_n_from(new_start, len);
+			throw;
+		}
+		destory_by_range(start, finish);
+		deallocate_n_from(start, end_of_storage - start);
+		start = new_start;
+		finish = new_finish;
+		end_of_storage = new_start + len;
+	}
+
+	// copy before C++11; afterwards move, unless moving could throw;
+	pointer			relocate_by_range(pointer r_first, pointer r_last, pointer d_first) {
+#if __cplusplus >= 201103L
+		pointer	curr = d_first;
+
+		try
+		{
+			for (; r_first != r_last; ++r_first, ++curr) {
+				alloc_traits::construct(data_allocator, curr, std::move_if_noexcept(*r_first));
+			}
+		}
+		catch(...)
+		{
+			destory_by_range(d_first, curr);
+			throw;
+		}
+		return curr;
+#else
+		return construct_by_range(r_first, r_last, d_first);
+#endif
+	}
+
+	// bitwise move: no copy constructors, no destructors at the old address;
+	void			relocate_storage(size_type n, true_type) {
+		const size_type	old_size = size();
+
+		start = reallocate_n_from(start, old_size, end_of_storage - start, n, reallocate_category());
+		finish = start + old_size;
+		end_of_storage = start + n;
+	}
+
+	pointer			reallocate_n_from(pointer first, size_type count, size_type old_n, size_type n, false_type) {
+		pointer	new_start = allocate_n(n);
+
+		if (count != 0) {
+			std::memcpy(static_cast<void*>(new_start), static_cast<const void*>(first), count * sizeof(T));
+		}
+		deallocate_n_from(first, old_n);
+		return new_start;
+	}
+
+	// realloc() can extend the block in place, or remap large ones;
+	pointer			reallocate_n_from(pointer first, size_type, size_type old_n, size_type n, true_type) {
+		if (first == 0) {
+			return allocate_n(n);
+		}
+		return data_allocator.reallocate(first, old_n, n);
+	}
+
 	void			deallocate_n_from(pointer first, size_type n) {
 		if (first) {
 			data_allocator.deallocate(first, n);
@@ -376,6 +643,11 @@ private:
 	template<typename Iterator>
 	pointer			construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, \
 	typename ft::enable_if<!ft::is_integral<Iterator>::value, Iterator>::type* = 0) {
+		return do_construct_by_range(r_first, r_last, d_first, trivial_category());
+	}
+
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, false_type) {
 		pointer	curr = d_first;
 
 		for (; r_first != r_last; ++r_first, ++curr) {
@@ -392,39 +664,197 @@ private:
 		return curr;
 	}
 
+	template<typename Iterator>
+	pointer			do_construct_by_range(Iterator r_first, Iterator r_last, pointer d_first, true_type) {
+		return do_construct_by_range(r_first, r_last, d_first, false_type());
+	}
+
+	pointer			do_construct_by_range(pointer r_first, pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	pointer			do_construct_by_range(const_pointer r_first, const_pointer r_last, pointer d_first, true_type) {
+		return copy_trivial(r_first, r_last, d_first);
+	}
+
+	// source and destination never overlap when constructing;
+	pointer			copy_trivial(const_pointer r_first, const_pointer r_last, pointer d_first) {
+		const size_type	n = r_last - r_first;
+		if (n != 0) {
+			std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(r_first), n * sizeof(T));
+		}
+		return d_first + n;
+	}
+
 	pointer			construct_n(pointer first, size_type n, const T& value) {
-		for (; n > 0; --n, ++first) {
-			data_allocator.construct(first, value);
+		return do_construct_n(first, n, value, trivial_category());
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, false_type) {
+		pointer	curr = first;
+
+		try
+		{
+			for (; n > 0; --n, ++curr) {
+				data_allocator.construct(curr, value);
+			}
 		}
-		return first;
+		catch(...)
+		{
+			destory_by_range(first, curr);
+			throw;
+		}
+		return curr;
+	}
+
+	pointer			do_construct_n(pointer first, size_type n, const T& value, true_type) {
+		std::fill_n(first, n, value);
+		return first + n;
+	}
+
+	pointer			default_construct_n(pointer first, size_type n, false_type) {
+		pointer	curr = first;
+
+		try
+		{
+			for (; n > 0; --n, ++curr) {
+				new(static_cast<void*>(curr)) T;
+			}
+		}
+		catch(...)
+		{
+			destory_by_range(first, curr);
+			throw;
+		}
+		return curr;
+	}
+
+	pointer			default_construct_n(pointer first, size_type n, true_type) {
+		return first + n;
 	}
 
 	template <class Iterator>
 	void			destory_by_range(Iterator r_first, Iterator r_last, \
 	typename ft::enable_if<!ft::is_integral<Iterator>::value, Iterator>::type* = 0) {
+		do_destroy_by_range(r_first, r_last, trivial_category());
+	}
+
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator r_first, Iterator r_last, false_type) {
 		for (; r_first != r_last; r_first++) {
 			data_allocator.destroy(r_first);
 		}
 	}
 
+	template <class Iterator>
+	void			do_destroy_by_range(Iterator, Iterator, true_type) {}
+
 	void			destroy_n(pointer first, size_type n) {
-		for (; n > 0; --n, ++first) {
-			data_allocator.destroy(first);
+		destory_by_range(first, first + n);
+	}
+
+	template<class InputIterator>
+	void	range_assign(InputIterator first, InputIterator last, input_iterator_tag) {
+		iterator	curr = begin();
+
+		for (; first != last && curr != end(); ++first, ++curr) {
+			*curr = *first;
+		}
+		if (first == last) {
+			erase(curr, end());
+		} else {
+			range_insert(end(), first, last, input_iterator_tag());
 		}
 	}
 
+	template<class ForwardIterator>
+	void	range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		const size_type	n = ft::distance(first, last);
+
+		if (n > capacity()) {
+			pointer	new_start = allocate_n(n);
+			try
+			{
+				construct_by_range(first, last, new_start);
+			}
+			catch(...)
+			{
+				deallocate_n_from(new_start, n);
+				throw;
+			}
+			destory_by_range(start, finish);
+			deallocate_n_from(start, end_of_storage - start);
+			start = new_start;
+			finish = new_start + n;
+			end_of_storage = finish;
+		} else if (size() >= n) {
+			iterator	i(std::copy(first, last, begin()));
+			destory_by_range(i, end());
+			finish = i;
+		} else {
+			ForwardIterator	mid = first;
+			for (size_type i = size(); i > 0; --i) {
+				++mid;
+			}
+			std::copy(first, mid, begin());
+			finish = construct_by_range(mid, last, finish);
+		}
+	}
+
+	// single pass sources: grow at the tail like push_back;
 	template<class InputIterator>
-	void	range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+	void	range_initialize(InputIterator first, InputIterator last, input_iterator_tag) {
 		for (; first != last; ++first) {
-			position = insert(position, *first);
-			++position;
+			push_back(*(first));
 		}
 	}
 
+	template<class ForwardIterator>
+	void	range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		size_type	n = ft::distance(first, last);
+		start = allocate_n(n);
+		end_of_storage = start + n;
+		try
+		{
+			finish = construct_by_range(first, last, start);
+		}
+		catch(...)
+		{
+			deallocate_n_from(start, n);
+			throw;
+		}
+	}
+
+	// the length is unknown up front: append everything at the tail, then
+	// rotate the new block into place once instead of shifting per element;
+	template<class InputIterator>
+	void	range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+		const size_type	offset = position - begin();
+		const size_type	old_size = size();
+
+		try
+		{
+			for (; first != last; ++first) {
+				push_back(*first);
+			}
+		}
+		catch(...)
+		{
+			erase(begin() + old_size, end());
+			throw;
+		}
+		std::rotate(begin() + offset, begin() + old_size, end());
+	}
+
 	template<class ForwardIterator>
 	void	range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
 		if (first != last) {
 			size_type	n = ft::distance(first, last);
+			if (size_type(end_of_storage - finish) < n && relocate_category::value) {
+				const size_type	offset = position - begin();
+				relocate_storage(next_capacity(n), relocate_category());
+				position = begin() + offset;
+			}
 			if (size_type(end_of_storage - finish) >= n) {
 				const size_type	elem_after = end() - position;
 				iterator	old_finish(finish);
@@ -445,27 +875,19 @@ private:
 					std::copy(first, mid, position);
 				}
 			} else {
-				const size_type	old_size = size();
-				const size_type	len = old_size + std::max(old_size, n);
-				iterator			new_start(allocate_n(len));
-				iterator			new_finish(new_start);
+				const size_type	len = next_capacity(n);
+				const size_type	offset = position - begin();
+				pointer			new_start = allocate_n(len);
 				try
 				{
-					new_finish = construct_by_range(iterator(start), position, new_start);
-					new_finish = construct_by_range(first, last, new_finish);
-					new_finish = construct_by_range(position, iterator(finish), new_finish);
+					construct_by_range(first, last, new_start + offset);
 				}
 				catch(...)
 				{
-					destory_by_range(new_start, new_finish);
 					deallocate_n_from(new_start, len);
 					throw;
 				}
-				destory_by_range(start, finish);
-				deallocate_n_from(start, end_of_storage - start);
-				start = new_start;
-				finish = new_finish;
-				end_of_storage = new_start + len;
+				relocate_around_gap(new_start, len, offset, n);
 			}
 		 }
 	}
@@ -474,41 +896,51 @@ private:
 };
 
 // Operator Overloading;
-template <class T, class Allocator>
-bool	operator==(const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator==(const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
 }
 
-template <class T, class Allocator>
-bool	operator< (const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator< (const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
-template <class T, class Allocator>
-bool	operator!=(const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator!=(const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return !(x == y);
 }
 
-template <class T, class Allocator>
-bool	operator> (const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator> (const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return y < x;
 }
 
-template <class T, class Allocator>
-bool	operator>=(const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator>=(const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return !(x < y);
 }
 
-template <class T, class Allocator>
-bool	operator<=(const vector<T,Allocator>& x, const vector<T,Allocator>& y) {
+template <class T, class Allocator, class Growth>
+bool	operator<=(const vector<T,Allocator,Growth>& x, const vector<T,Allocator,Growth>& y) {
 	return !(y < x);
 }
 
-template <class T, class Allocator>
-void	swap(vector<T, Allocator>& x, vector<T, Allocator>& y) {
+template <class T, class Allocator, class Growth>
+void	swap(vector<T, Allocator, Growth>& x, vector<T, Allocator, Growth>& y) {
 	x.swap(y);
 }
 
+// removes every element matching pred in one pass; returns how many went;
+template <class T, class Allocator, class Growth, class Predicate>
+typename vector<T, Allocator, Growth>::size_type	erase_if(vector<T, Allocator, Growth>& c, Predicate pred) {
+	typename vector<T, Allocator, Growth>::iterator		it = std::remove_if(c.begin(), c.end(), pred);
+	typename vector<T, Allocator, Growth>::size_type	n = c.end() - it;
+
+	c.erase(it, c.end());
+	return n;
+}
+
 }
 
 #endif